@@ -43,6 +43,7 @@
 #include "mutt_curses.h"
 #include "mutt_idna.h"
 #include "options.h"
+#include "pattern.h"
 #include "protos.h"
 #include "rfc822.h"
 
@@ -391,6 +392,8 @@ retry_name:
   }
 
   mutt_alias_add_reverse(new);
+  /* ~f @alias patterns may now match different messages */
+  mutt_pattern_memo_invalidate(NULL);
 
   if ((t = Aliases))
   {
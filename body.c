@@ -26,6 +26,7 @@
 #include <unistd.h>
 #include "lib/debug.h"
 #include "lib/memory.h"
+#include "lib/pool.h"
 #include "lib/string2.h"
 #include "body.h"
 #include "header.h"
@@ -33,9 +34,11 @@
 #include "parameter.h"
 #include "protos.h"
 
+static struct Pool BodyPool = POOL_INITIALIZER(struct Body);
+
 struct Body *mutt_new_body(void)
 {
-  struct Body *p = safe_calloc(1, sizeof(struct Body));
+  struct Body *p = mutt_pool_alloc(&BodyPool);
 
   p->disposition = DISPATTACH;
   p->use_disp = true;
@@ -155,7 +158,7 @@ void mutt_free_body(struct Body **p)
     if (b->parts)
       mutt_free_body(&b->parts);
 
-    FREE(&b);
+    mutt_pool_free(&BodyPool, &b);
   }
 
   *p = 0;
@@ -0,0 +1,315 @@
+/**
+ * @file
+ * Persistent body search index
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page bodyidx Persistent body search index
+ *
+ * Searching message bodies (~b, ~B, ~h) means opening, decoding and scanning
+ * every message.  The body index remembers, for each message, a signature of
+ * the text that was scanned: a bitmap of the (case-folded) byte trigrams it
+ * contains.  The signatures are stored in the header cache, next to the
+ * message's header, using the same key.
+ *
+ * Before a message is searched for a pattern that requires a literal string,
+ * the literal's trigrams are looked up in the signature.  If any of them is
+ * missing, the message cannot match and doesn't need to be opened.  Otherwise
+ * the message is searched as usual, so the index never changes the result of
+ * a search.
+ */
+
+#include "config.h"
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include "lib/lib.h"
+#include "bodyidx.h"
+#include "body.h"
+#include "context.h"
+#include "globals.h"
+#include "header.h"
+#include "mailbox.h"
+#include "mutt.h"
+#include "options.h"
+#include "protos.h"
+#include "hcache/hcache.h"
+#include "mx.h"
+
+#define BODYIDX_MAGIC 0x42495802 /**< "BIX" + format version */
+#define BODYIDX_MIN_BITS 1024
+#define BODYIDX_MAX_BITS 131072
+
+/**
+ * enum BodyIndexFlag - Flags describing how a signature was built
+ */
+enum BodyIndexFlag
+{
+  BODYIDX_THOROUGH = 1 << 0, /**< Built with $thorough_search set */
+};
+
+/**
+ * struct BodyIndex - Body index of an open mailbox
+ */
+struct BodyIndex
+{
+  struct Context *ctx;
+  header_cache_t *hc;
+};
+
+/**
+ * struct BodySignature - Trigram bitmap of a message's text
+ */
+struct BodySignature
+{
+  unsigned int nbits; /**< size of the bitmap, a power of two */
+  unsigned char *bits;
+};
+
+/**
+ * struct BodyIndexRecord - Header of a stored signature
+ *
+ * The fields are used to detect stale records, e.g. when an MH message number
+ * is reused for a different message, or a message is edited in place.
+ */
+struct BodyIndexRecord
+{
+  unsigned int magic;
+  unsigned int flags;
+  unsigned int nbits;
+  LOFF_T length;
+  time_t date_sent;
+  time_t received;
+  LOFF_T size;
+  time_t mtime;
+};
+
+static inline unsigned int trigram_hash(unsigned char a, unsigned char b, unsigned char c)
+{
+  unsigned int h = 2166136261U;
+  h = (h ^ tolower(a)) * 16777619U;
+  h = (h ^ tolower(b)) * 16777619U;
+  h = (h ^ tolower(c)) * 16777619U;
+  return h ^ (h >> 15);
+}
+
+static int bodyidx_key(struct Context *ctx, struct Header *h, int op, char *buf, size_t buflen)
+{
+  const char *key = NULL;
+  size_t keylen;
+  char opc;
+
+  if (!h->path)
+    return -1;
+
+  if (ctx->magic == MUTT_MH)
+  {
+    key = h->path;
+    keylen = strlen(key);
+  }
+  else
+  {
+    key = h->path + 3;
+    keylen = maildir_hcache_keylen(key);
+  }
+
+  switch (op)
+  {
+    case MUTT_BODY:
+      opc = 'b';
+      break;
+    case MUTT_HEADER:
+      opc = 'h';
+      break;
+    case MUTT_WHOLE_MSG:
+      opc = 'B';
+      break;
+    default:
+      return -1;
+  }
+
+  snprintf(buf, buflen, "bodyidx:%c:%.*s", opc, (int) keylen, key);
+  return 0;
+}
+
+static int record_init(struct BodyIndexRecord *rec, struct Context *ctx,
+                       struct Header *h, unsigned int nbits)
+{
+  char path[_POSIX_PATH_MAX];
+  struct stat st;
+
+  snprintf(path, sizeof(path), "%s/%s", ctx->path, h->path);
+  if (stat(path, &st) != 0)
+    return -1;
+
+  memset(rec, 0, sizeof(*rec));
+  rec->magic = BODYIDX_MAGIC;
+  rec->flags = option(OPT_THOROUGH_SEARCH) ? BODYIDX_THOROUGH : 0;
+  rec->nbits = nbits;
+  rec->length = h->content ? h->content->length : 0;
+  rec->date_sent = h->date_sent;
+  rec->received = h->received;
+  rec->size = st.st_size;
+  rec->mtime = st.st_mtime;
+  return 0;
+}
+
+struct BodyIndex *mutt_bodyidx_open(struct Context *ctx)
+{
+  if (!ctx || !option(OPT_BODY_INDEX) || !HeaderCache)
+    return NULL;
+
+  if ((ctx->magic != MUTT_MAILDIR) && (ctx->magic != MUTT_MH))
+    return NULL;
+
+  header_cache_t *hc = mutt_hcache_open(HeaderCache, ctx->path, NULL);
+  if (!hc)
+    return NULL;
+
+  struct BodyIndex *idx = safe_calloc(1, sizeof(struct BodyIndex));
+  idx->ctx = ctx;
+  idx->hc = hc;
+  return idx;
+}
+
+void mutt_bodyidx_close(struct BodyIndex **idx)
+{
+  if (!idx || !*idx)
+    return;
+
+  mutt_hcache_close((*idx)->hc);
+  FREE(idx);
+}
+
+int mutt_bodyidx_check(struct BodyIndex *idx, struct Context *ctx,
+                       struct Header *h, int op, const char *literal)
+{
+  char key[_POSIX_PATH_MAX];
+  struct BodyIndexRecord rec;
+  struct BodyIndexRecord want;
+  void *data = NULL;
+  size_t dlen = 0;
+  int rc = 1;
+
+  if (!idx || (idx->ctx != ctx) || (bodyidx_key(ctx, h, op, key, sizeof(key)) != 0))
+    return -1;
+
+  data = mutt_hcache_fetch_raw_len(idx->hc, key, strlen(key), &dlen);
+  if (!data)
+    return -1;
+
+  /* Don't trust a truncated or corrupt record */
+  if (dlen < sizeof(rec))
+  {
+    mutt_hcache_free(idx->hc, &data);
+    return -1;
+  }
+
+  memcpy(&rec, data, sizeof(rec));
+  if ((record_init(&want, ctx, h, rec.nbits) != 0) ||
+      (rec.magic != want.magic) || (rec.flags != want.flags) ||
+      (rec.length != want.length) || (rec.date_sent != want.date_sent) ||
+      (rec.received != want.received) || (rec.size != want.size) ||
+      (rec.mtime != want.mtime) || (rec.nbits < BODYIDX_MIN_BITS) ||
+      (rec.nbits > BODYIDX_MAX_BITS) || (rec.nbits & (rec.nbits - 1)) ||
+      (dlen != sizeof(rec) + rec.nbits / 8))
+  {
+    mutt_hcache_free(idx->hc, &data);
+    return -1;
+  }
+
+  const unsigned char *bits = (const unsigned char *) data + sizeof(rec);
+  const unsigned char *s = (const unsigned char *) (literal ? literal : "");
+  for (; s[0] && s[1] && s[2]; s++)
+  {
+    /* Case-insensitive matching of non-ASCII characters doesn't preserve
+     * bytes, so only pure ASCII trigrams can rule a message out */
+    if ((s[0] & 0x80) || (s[1] & 0x80) || (s[2] & 0x80))
+      continue;
+
+    unsigned int bit = trigram_hash(s[0], s[1], s[2]) & (rec.nbits - 1);
+    if (!(bits[bit / 8] & (1 << (bit % 8))))
+    {
+      rc = 0;
+      break;
+    }
+  }
+
+  mutt_hcache_free(idx->hc, &data);
+  return rc;
+}
+
+struct BodySignature *mutt_bodyidx_sig_new(long size)
+{
+  struct BodySignature *sig = safe_calloc(1, sizeof(struct BodySignature));
+
+  /* Aim for roughly two bits per byte of text, to keep false positives low */
+  sig->nbits = BODYIDX_MIN_BITS;
+  while ((sig->nbits < BODYIDX_MAX_BITS) && ((long) sig->nbits < size * 2))
+    sig->nbits <<= 1;
+
+  sig->bits = safe_calloc(1, sig->nbits / 8);
+  return sig;
+}
+
+void mutt_bodyidx_sig_add(struct BodySignature *sig, const char *buf)
+{
+  if (!sig || !buf)
+    return;
+
+  const unsigned char *s = (const unsigned char *) buf;
+  for (; s[0] && s[1] && s[2]; s++)
+  {
+    unsigned int bit = trigram_hash(s[0], s[1], s[2]) & (sig->nbits - 1);
+    sig->bits[bit / 8] |= (1 << (bit % 8));
+  }
+}
+
+void mutt_bodyidx_sig_free(struct BodySignature **sig)
+{
+  if (!sig || !*sig)
+    return;
+
+  FREE(&(*sig)->bits);
+  FREE(sig);
+}
+
+int mutt_bodyidx_store(struct BodyIndex *idx, struct Context *ctx,
+                       struct Header *h, int op, struct BodySignature *sig)
+{
+  char key[_POSIX_PATH_MAX];
+  struct BodyIndexRecord rec;
+
+  if (!idx || !sig || (idx->ctx != ctx) || (bodyidx_key(ctx, h, op, key, sizeof(key)) != 0))
+    return -1;
+
+  if (record_init(&rec, ctx, h, sig->nbits) != 0)
+    return -1;
+
+  size_t dlen = sizeof(rec) + sig->nbits / 8;
+  unsigned char *data = safe_malloc(dlen);
+  memcpy(data, &rec, sizeof(rec));
+  memcpy(data + sizeof(rec), sig->bits, sig->nbits / 8);
+
+  int rc = mutt_hcache_store_raw(idx->hc, key, strlen(key), data, dlen);
+  FREE(&data);
+
+  return (rc == 0) ? 0 : -1;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file
+ * Persistent body search index
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MUTT_BODYIDX_H
+#define _MUTT_BODYIDX_H
+
+#include <stddef.h>
+
+struct Context;
+struct Header;
+struct BodyIndex;
+struct BodySignature;
+
+/**
+ * mutt_bodyidx_open - Open the body index of a mailbox
+ * @param ctx Mailbox
+ * @retval ptr  Body index, stored alongside the header cache
+ * @retval NULL if $body_index is unset, there is no header cache, or the
+ *              mailbox type has no stable per-message cache keys
+ */
+struct BodyIndex *mutt_bodyidx_open(struct Context *ctx);
+
+/**
+ * mutt_bodyidx_close - Close a body index
+ * @param idx Body index from mutt_bodyidx_open()
+ */
+void mutt_bodyidx_close(struct BodyIndex **idx);
+
+/**
+ * mutt_bodyidx_check - Can a literal possibly occur in a message?
+ * @param idx     Body index from mutt_bodyidx_open()
+ * @param ctx     Mailbox
+ * @param h       Message
+ * @param op      Search operation, e.g. #MUTT_BODY
+ * @param literal String that every match must contain
+ * @retval  1 The literal may occur; the message must be searched
+ * @retval  0 The literal definitely does not occur
+ * @retval -1 The message hasn't been indexed yet
+ */
+int mutt_bodyidx_check(struct BodyIndex *idx, struct Context *ctx,
+                       struct Header *h, int op, const char *literal);
+
+/**
+ * mutt_bodyidx_sig_new - Start collecting the signature of a message
+ * @param size Approximate number of bytes that will be added
+ * @retval ptr New, empty signature
+ */
+struct BodySignature *mutt_bodyidx_sig_new(long size);
+
+/**
+ * mutt_bodyidx_sig_add - Add searched text to a signature
+ * @param sig Signature from mutt_bodyidx_sig_new()
+ * @param buf Text, as passed to the matcher
+ */
+void mutt_bodyidx_sig_add(struct BodySignature *sig, const char *buf);
+
+/**
+ * mutt_bodyidx_sig_free - Free a signature
+ * @param sig Signature to free
+ */
+void mutt_bodyidx_sig_free(struct BodySignature **sig);
+
+/**
+ * mutt_bodyidx_store - Save the signature of a message in the index
+ * @param idx Body index from mutt_bodyidx_open()
+ * @param ctx Mailbox
+ * @param h   Message
+ * @param op  Search operation the signature was built for
+ * @param sig Complete signature
+ * @retval 0 on success
+ * @retval -1 on failure
+ */
+int mutt_bodyidx_store(struct BodyIndex *idx, struct Context *ctx,
+                       struct Header *h, int op, struct BodySignature *sig);
+
+#endif /* _MUTT_BODYIDX_H */
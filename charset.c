@@ -25,6 +25,7 @@
 #include <errno.h>
 #include <langinfo.h>
 #include <limits.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 #include "lib/lib.h"
@@ -37,6 +38,26 @@
 #define EILSEQ EINVAL
 #endif
 
+#define ICONV_CACHE_SIZE 16
+
+/**
+ * struct IconvCacheEntry - A reusable iconv conversion descriptor
+ *
+ * Opening a descriptor is expensive, and many are needed for short
+ * conversions, e.g. one for every encoded word in a header.
+ */
+struct IconvCacheEntry
+{
+  char tocode[SHORT_STRING];   /**< target charset, after hooks */
+  char fromcode[SHORT_STRING]; /**< source charset, after hooks */
+  iconv_t cd;                  /**< conversion descriptor */
+  bool busy;                   /**< handed out by mutt_iconv_open() */
+  unsigned int used;           /**< last use, for LRU; 0 if the entry is empty */
+};
+
+static struct IconvCacheEntry IconvCache[ICONV_CACHE_SIZE];
+static unsigned int IconvCacheClock = 0;
+
 /*
  * The following list has been created manually from the data under:
  * http://www.isi.edu/in-notes/iana/assignments/character-sets
@@ -310,28 +331,22 @@ char *mutt_get_default_charset(void)
 }
 
 /**
- * mutt_iconv_open - Set up iconv for conversions
+ * iconv_names - Work out the charset names to give to iconv
+ * @param[in]  tocode    Target charset
+ * @param[in]  fromcode  Source charset
+ * @param[in]  flags     Flags, e.g. #MUTT_ICONV_HOOK_FROM
+ * @param[out] tocode2   Buffer for the target name, SHORT_STRING bytes
+ * @param[out] fromcode2 Buffer for the source name, SHORT_STRING bytes
  *
- * Like iconv_open, but canonicalises the charsets, applies charset-hooks,
- * recanonicalises, and finally applies iconv-hooks. Parameter flags=0 skips
- * charset-hooks, while MUTT_ICONV_HOOK_FROM applies them to fromcode. Callers
- * should use flags=0 when fromcode can safely be considered true, either some
- * constant, or some value provided by the user; MUTT_ICONV_HOOK_FROM should be
- * used only when fromcode is unsure, taken from a possibly wrong incoming MIME
- * label, or such. Misusing MUTT_ICONV_HOOK_FROM leads to unwanted interactions
- * in some setups. Note: By design charset-hooks should never be, and are never,
- * applied to tocode. Highlight note: The top-well-named MUTT_ICONV_HOOK_FROM
- * acts on charset-hooks, not at all on iconv-hooks.
+ * See mutt_iconv_open() for the hooks that are applied.
  */
-iconv_t mutt_iconv_open(const char *tocode, const char *fromcode, int flags)
+static void iconv_names(const char *tocode, const char *fromcode, int flags,
+                        char *tocode2, char *fromcode2)
 {
   char tocode1[SHORT_STRING];
   char fromcode1[SHORT_STRING];
-  char *tocode2 = NULL, *fromcode2 = NULL;
   char *tmp = NULL;
 
-  iconv_t cd;
-
   /* transform to MIME preferred charset names */
   mutt_canonical_charset(tocode1, sizeof(tocode1), tocode);
   mutt_canonical_charset(fromcode1, sizeof(fromcode1), fromcode);
@@ -343,17 +358,149 @@ iconv_t mutt_iconv_open(const char *tocode, const char *fromcode, int flags)
     mutt_canonical_charset(fromcode1, sizeof(fromcode1), tmp);
 
   /* always apply iconv-hooks to suit system's iconv tastes */
-  tocode2 = mutt_iconv_hook(tocode1);
-  tocode2 = (tocode2) ? tocode2 : tocode1;
-  fromcode2 = mutt_iconv_hook(fromcode1);
-  fromcode2 = (fromcode2) ? fromcode2 : fromcode1;
+  tmp = mutt_iconv_hook(tocode1);
+  strfcpy(tocode2, tmp ? tmp : tocode1, SHORT_STRING);
+  tmp = mutt_iconv_hook(fromcode1);
+  strfcpy(fromcode2, tmp ? tmp : fromcode1, SHORT_STRING);
+}
+
+/**
+ * iconv_cache_find - Find an idle cached descriptor
+ * @param tocode   Target charset, as given to iconv_open()
+ * @param fromcode Source charset, as given to iconv_open()
+ * @retval ptr  Cache entry
+ * @retval NULL if there is no idle descriptor for the conversion
+ */
+static struct IconvCacheEntry *iconv_cache_find(const char *tocode, const char *fromcode)
+{
+  for (int i = 0; i < ICONV_CACHE_SIZE; i++)
+  {
+    struct IconvCacheEntry *ice = &IconvCache[i];
+    if ((ice->used != 0) && !ice->busy && (strcmp(ice->tocode, tocode) == 0) &&
+        (strcmp(ice->fromcode, fromcode) == 0))
+    {
+      return ice;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * iconv_cache_slot - Make room for a new descriptor in the cache
+ * @retval ptr  Empty cache entry
+ * @retval NULL if every cached descriptor is in use
+ *
+ * The least recently used idle descriptor is closed, if necessary.
+ */
+static struct IconvCacheEntry *iconv_cache_slot(void)
+{
+  struct IconvCacheEntry *lru = NULL;
+
+  for (int i = 0; i < ICONV_CACHE_SIZE; i++)
+  {
+    struct IconvCacheEntry *ice = &IconvCache[i];
+    if (ice->used == 0)
+      return ice;
+    if (!ice->busy && (!lru || (ice->used < lru->used)))
+      lru = ice;
+  }
+
+  if (lru)
+    iconv_close(lru->cd);
+
+  return lru;
+}
+
+/**
+ * iconv_cache_open - Get a conversion descriptor, from the cache if possible
+ * @param tocode   Target charset, as given to iconv_open()
+ * @param fromcode Source charset, as given to iconv_open()
+ * @retval ptr Conversion descriptor
+ * @retval -1  if iconv doesn't support the conversion
+ */
+static iconv_t iconv_cache_open(const char *tocode, const char *fromcode)
+{
+  struct IconvCacheEntry *ice = NULL;
+  iconv_t cd;
+
+  /* reuse an idle descriptor for the same conversion */
+  ice = iconv_cache_find(tocode, fromcode);
+  if (ice)
+  {
+    ice->busy = true;
+    ice->used = ++IconvCacheClock;
+    return ice->cd;
+  }
 
   /* call system iconv with names it appreciates */
-  cd = iconv_open(tocode2, fromcode2);
-  if (cd != (iconv_t) -1)
-    return cd;
+  cd = iconv_open(tocode, fromcode);
+  if (cd == (iconv_t) -1)
+    return (iconv_t) -1;
 
-  return (iconv_t) -1;
+  ice = iconv_cache_slot();
+  if (ice)
+  {
+    strfcpy(ice->tocode, tocode, sizeof(ice->tocode));
+    strfcpy(ice->fromcode, fromcode, sizeof(ice->fromcode));
+    ice->cd = cd;
+    ice->busy = true;
+    ice->used = ++IconvCacheClock;
+  }
+
+  return cd;
+}
+
+/**
+ * mutt_iconv_open - Set up iconv for conversions
+ *
+ * Like iconv_open, but canonicalises the charsets, applies charset-hooks,
+ * recanonicalises, and finally applies iconv-hooks. Parameter flags=0 skips
+ * charset-hooks, while MUTT_ICONV_HOOK_FROM applies them to fromcode. Callers
+ * should use flags=0 when fromcode can safely be considered true, either some
+ * constant, or some value provided by the user; MUTT_ICONV_HOOK_FROM should be
+ * used only when fromcode is unsure, taken from a possibly wrong incoming MIME
+ * label, or such. Misusing MUTT_ICONV_HOOK_FROM leads to unwanted interactions
+ * in some setups. Note: By design charset-hooks should never be, and are never,
+ * applied to tocode. Highlight note: The top-well-named MUTT_ICONV_HOOK_FROM
+ * acts on charset-hooks, not at all on iconv-hooks.
+ *
+ * Descriptors are cached, so release them with mutt_iconv_close(), not
+ * iconv_close().
+ */
+iconv_t mutt_iconv_open(const char *tocode, const char *fromcode, int flags)
+{
+  char tocode2[SHORT_STRING];
+  char fromcode2[SHORT_STRING];
+
+  iconv_names(tocode, fromcode, flags, tocode2, fromcode2);
+  return iconv_cache_open(tocode2, fromcode2);
+}
+
+/**
+ * mutt_iconv_close - Finish with a conversion descriptor
+ * @param cd Descriptor from mutt_iconv_open()
+ *
+ * A cached descriptor is reset to its initial state and kept for the next
+ * mutt_iconv_open() of the same conversion.
+ */
+void mutt_iconv_close(iconv_t cd)
+{
+  if (cd == (iconv_t) -1)
+    return;
+
+  for (int i = 0; i < ICONV_CACHE_SIZE; i++)
+  {
+    struct IconvCacheEntry *ice = &IconvCache[i];
+    if (ice->busy && (ice->cd == cd))
+    {
+      iconv(cd, 0, 0, 0, 0);
+      ice->busy = false;
+      return;
+    }
+  }
+
+  iconv_close(cd);
 }
 
 /**
@@ -434,6 +581,67 @@ size_t mutt_iconv(iconv_t cd, ICONV_CONST char **inbuf, size_t *inbytesleft,
   }
 }
 
+/**
+ * mutt_utf8_span - Measure the valid UTF-8 at the start of a buffer
+ * @param s   Buffer to check
+ * @param len Length of the buffer
+ * @retval num Number of bytes that form complete, well-formed characters
+ *
+ * Checking stops at the first invalid or incomplete character.  Overlong
+ * forms, surrogates and code points beyond U+10FFFF are rejected, like iconv
+ * does.
+ */
+size_t mutt_utf8_span(const char *s, size_t len)
+{
+  const unsigned char *p = (const unsigned char *) s;
+  size_t i = 0;
+
+  while (i < len)
+  {
+    if (p[i] < 0x80)
+    {
+      i++;
+      continue;
+    }
+
+    size_t n;
+    unsigned char lo = 0x80, hi = 0xbf;
+    if ((p[i] >= 0xc2) && (p[i] <= 0xdf))
+      n = 1;
+    else if ((p[i] >= 0xe0) && (p[i] <= 0xef))
+    {
+      n = 2;
+      if (p[i] == 0xe0)
+        lo = 0xa0;
+      else if (p[i] == 0xed)
+        hi = 0x9f;
+    }
+    else if ((p[i] >= 0xf0) && (p[i] <= 0xf4))
+    {
+      n = 3;
+      if (p[i] == 0xf0)
+        lo = 0x90;
+      else if (p[i] == 0xf4)
+        hi = 0x8f;
+    }
+    else
+      break;
+
+    if ((len - i <= n) || (p[i + 1] < lo) || (p[i + 1] > hi))
+      break;
+
+    size_t k;
+    for (k = 2; (k <= n) && ((p[i + k] & 0xc0) == 0x80); k++)
+      ;
+    if (k <= n)
+      break;
+
+    i += n + 1;
+  }
+
+  return i;
+}
+
 /**
  * mutt_convert_string - Convert a string between encodings
  *
@@ -442,14 +650,28 @@ size_t mutt_iconv(iconv_t cd, ICONV_CONST char **inbuf, size_t *inbytesleft,
  */
 int mutt_convert_string(char **ps, const char *from, const char *to, int flags)
 {
-  iconv_t cd;
+  iconv_t cd = (iconv_t) -1;
   ICONV_CONST char *repls[] = { "\357\277\275", "?", 0 };
   char *s = *ps;
+  char tocode2[SHORT_STRING];
+  char fromcode2[SHORT_STRING];
 
   if (!s || !*s)
     return 0;
 
-  if (to && from && (cd = mutt_iconv_open(to, from, flags)) != (iconv_t) -1)
+  if (to && from)
+  {
+    iconv_names(to, from, flags, tocode2, fromcode2);
+
+    /* Converting valid UTF-8 to UTF-8 wouldn't change anything */
+    if (mutt_is_utf8(tocode2) && mutt_is_utf8(fromcode2) &&
+        (mutt_utf8_span(s, strlen(s)) == strlen(s)))
+      return 0;
+
+    cd = iconv_cache_open(tocode2, fromcode2);
+  }
+
+  if (cd != (iconv_t) -1)
   {
     int len;
     ICONV_CONST char *ib = NULL;
@@ -472,7 +694,7 @@ int mutt_convert_string(char **ps, const char *from, const char *to, int flags)
     ob = buf = safe_malloc(obl + 1);
 
     mutt_iconv(cd, &ib, &ibl, &ob, &obl, inrepls, outrepl);
-    iconv_close(cd);
+    mutt_iconv_close(cd);
 
     *ob = '\0';
 
@@ -621,12 +843,51 @@ int fgetconv(FGETCONV *_fc)
   return EOF;
 }
 
+/**
+ * fgetconv_read - Read a block of converted text
+ * @param _fc  Converter from fgetconv_open()
+ * @param buf  Buffer for the text
+ * @param len  Length of the buffer
+ * @retval num Number of bytes read, 0 at the end of the file
+ *
+ * If no conversion is needed, the file is read directly.
+ */
+size_t fgetconv_read(FGETCONV *_fc, char *buf, size_t len)
+{
+  struct FgetConv *fc = (struct FgetConv *) _fc;
+  size_t r = 0;
+
+  if (!fc)
+    return 0;
+  if (fc->cd == (iconv_t) -1)
+    return fread(buf, 1, len, fc->file);
+
+  while (r < len)
+  {
+    if (fc->p && (fc->p < fc->ob))
+    {
+      size_t n = MIN((size_t)(fc->ob - fc->p), len - r);
+      memcpy(buf + r, fc->p, n);
+      fc->p += n;
+      r += n;
+      continue;
+    }
+
+    /* Let fgetconv() convert some more */
+    int c = fgetconv(_fc);
+    if (c == EOF)
+      break;
+    buf[r++] = (char) c;
+  }
+
+  return r;
+}
+
 void fgetconv_close(FGETCONV **_fc)
 {
   struct FgetConv *fc = (struct FgetConv *) *_fc;
 
-  if (fc->cd != (iconv_t) -1)
-    iconv_close(fc->cd);
+  mutt_iconv_close(fc->cd);
   FREE(_fc);
 }
 
@@ -648,7 +909,7 @@ bool mutt_check_charset(const char *s, bool strict)
   cd = mutt_iconv_open(s, s, 0);
   if (cd != (iconv_t)(-1))
   {
-    iconv_close(cd);
+    mutt_iconv_close(cd);
     return true;
   }
 
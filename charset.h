@@ -28,8 +28,10 @@
 #include <stdio.h>
 
 int mutt_convert_string(char **ps, const char *from, const char *to, int flags);
+size_t mutt_utf8_span(const char *s, size_t len);
 
 iconv_t mutt_iconv_open(const char *tocode, const char *fromcode, int flags);
+void mutt_iconv_close(iconv_t cd);
 size_t mutt_iconv(iconv_t cd, ICONV_CONST char **inbuf, size_t *inbytesleft,
                   char **outbuf, size_t *outbytesleft,
                   ICONV_CONST char **inrepls, const char *outrepl);
@@ -39,6 +41,7 @@ typedef void *FGETCONV;
 FGETCONV *fgetconv_open(FILE *file, const char *from, const char *to, int flags);
 int fgetconv(FGETCONV *_fc);
 char *fgetconvs(char *buf, size_t l, FGETCONV *_fc);
+size_t fgetconv_read(FGETCONV *_fc, char *buf, size_t len);
 void fgetconv_close(FGETCONV **_fc);
 
 void mutt_set_langinfo_charset(void);
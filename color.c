@@ -156,6 +156,28 @@ static struct ColorLine *new_color_line(void)
   return p;
 }
 
+/**
+ * regex_has_word_bounds - Does a regex look at the text before a match?
+ * @param s Regex
+ * @retval true If it contains a word boundary or buffer anchor, e.g. "\\<"
+ *
+ * The pager searches the rest of a line after each match, so a match of such
+ * a regex may depend on where the search starts.
+ */
+static bool regex_has_word_bounds(const char *s)
+{
+  for (; s && *s; s++)
+  {
+    if ((s[0] == '\\') && s[1])
+    {
+      if (strchr("<>bB`'", s[1]))
+        return true;
+      s++;
+    }
+  }
+  return false;
+}
+
 static void free_color_line(struct ColorLine *tmp, int free_colors)
 {
   if (!tmp)
@@ -173,6 +195,7 @@ static void free_color_line(struct ColorLine *tmp, int free_colors)
   regfree(&tmp->regex);
   mutt_pattern_free(&tmp->color_pattern);
   FREE(&tmp->pattern);
+  FREE(&tmp->literal);
   FREE(&tmp);
 }
 
@@ -643,7 +666,7 @@ static int add_pattern(struct ColorLineHead *top, const char *s, int sensitive,
     {
       strfcpy(buf, NONULL(s), sizeof(buf));
       mutt_check_simple(buf, sizeof(buf), NONULL(SimpleSearch));
-      tmp->color_pattern = mutt_pattern_comp(buf, MUTT_FULL_MSG, err);
+      tmp->color_pattern = mutt_pattern_comp(buf, MUTT_FULL_MSG | MUTT_PATTERN_MEMO, err);
       if (!tmp->color_pattern)
       {
         free_color_line(tmp, 1);
@@ -653,11 +676,18 @@ static int add_pattern(struct ColorLineHead *top, const char *s, int sensitive,
       for (int i = 0; Context && i < Context->msgcount; i++)
         Context->hdrs[i]->pair = 0;
     }
-    else if ((r = REGCOMP(&tmp->regex, s, (sensitive ? mutt_which_case(s) : REG_ICASE))) != 0)
+    else
     {
-      regerror(r, &tmp->regex, err->data, err->dsize);
-      free_color_line(tmp, 1);
-      return -1;
+      int flags = sensitive ? mutt_which_case(s) : REG_ICASE;
+      if ((r = REGCOMP(&tmp->regex, s, flags)) != 0)
+      {
+        regerror(r, &tmp->regex, err->data, err->dsize);
+        free_color_line(tmp, 1);
+        return -1;
+      }
+      tmp->literal = mutt_regex_literal(s);
+      tmp->icase = (flags & REG_ICASE);
+      tmp->word_bounds = regex_has_word_bounds(s);
     }
     tmp->pattern = safe_strdup(s);
     tmp->match = match;
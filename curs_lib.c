@@ -446,11 +446,35 @@ void mutt_curses_message(const char *fmt, ...)
   va_end(ap);
 }
 
-void mutt_progress_init(struct Progress *progress, const char *msg,
-                        unsigned short flags, unsigned short inc, long size)
+/**
+ * PROGRESS_FRAME_MS - Minimum time between two progress updates
+ *
+ * Mailboxes are read in tight loops that report their progress every few
+ * messages.  Painting the progress bar is much slower than reading a message,
+ * so however fast the loop, the bar isn't painted more than 20 times a second.
+ */
+#define PROGRESS_FRAME_MS 50
+
+/**
+ * progress_now - Get the current time for the progress bar
+ * @retval num Time in milliseconds, truncated to an unsigned int
+ * @retval 0   On error
+ */
+static unsigned int progress_now(void)
 {
   struct timeval tv = { 0, 0 };
 
+  if (gettimeofday(&tv, NULL) < 0)
+  {
+    mutt_debug(1, "gettimeofday failed: %d\n", errno);
+    return 0;
+  }
+  return ((unsigned int) tv.tv_sec * 1000) + (unsigned int) (tv.tv_usec / 1000);
+}
+
+void mutt_progress_init(struct Progress *progress, const char *msg,
+                        unsigned short flags, unsigned short inc, long size)
+{
   if (!progress)
     return;
   if (option(OPT_NO_CURSES))
@@ -476,12 +500,8 @@ void mutt_progress_init(struct Progress *progress, const char *msg,
       mutt_message(msg);
     return;
   }
-  if (gettimeofday(&tv, NULL) < 0)
-    mutt_debug(1, "gettimeofday failed: %d\n", errno);
   /* if timestamp is 0 no time-based suppression is done */
-  if (TimeInc)
-    progress->timestamp =
-        ((unsigned int) tv.tv_sec * 1000) + (unsigned int) (tv.tv_usec / 1000);
+  progress->timestamp = progress_now();
   mutt_progress_update(progress, 0, 0);
 }
 
@@ -549,7 +569,6 @@ void mutt_progress_update(struct Progress *progress, long pos, int percent)
 {
   char posstr[SHORT_STRING];
   bool update = false;
-  struct timeval tv = { 0, 0 };
   unsigned int now = 0;
 
   if (option(OPT_NO_CURSES))
@@ -564,11 +583,11 @@ void mutt_progress_update(struct Progress *progress, long pos, int percent)
   else if (pos >= progress->pos + progress->inc)
     update = true;
 
-  /* skip refresh if not enough time has passed */
-  if (update && progress->timestamp && !gettimeofday(&tv, NULL))
+  /* skip refresh if not enough time has passed.  The update isn't lost: the
+   * position isn't recorded, so the next call will try again */
+  if (update && progress->timestamp && (now = progress_now()))
   {
-    now = ((unsigned int) tv.tv_sec * 1000) + (unsigned int) (tv.tv_usec / 1000);
-    if (now && now - progress->timestamp < TimeInc)
+    if (now - progress->timestamp < MAX(TimeInc, PROGRESS_FRAME_MS))
       update = false;
   }
 
@@ -355,8 +355,7 @@ void update_index(struct Menu *menu, struct Context *ctx, int check, int oldcoun
       if (!i)
         ctx->vcount = 0;
 
-      if (mutt_pattern_exec(ctx->limit_pattern, MUTT_MATCH_FULL_ADDRESS, ctx,
-                            ctx->hdrs[i], NULL))
+      if (mutt_pattern_exec(ctx->limit_pattern, MUTT_MATCH_FULL_ADDRESS, ctx, ctx->hdrs[i]))
       {
         assert(ctx->vcount < ctx->msgcount);
         ctx->hdrs[i]->virtual = ctx->vcount;
@@ -402,12 +401,9 @@ void update_index(struct Menu *menu, struct Context *ctx, int check, int oldcoun
     {
       for (int i = 0; i < ctx->msgcount - oldcount; i++)
       {
-        for (int k = 0; k < ctx->msgcount; k++)
-        {
-          struct Header *h = ctx->hdrs[k];
-          if (h == save_new[i] && (!ctx->pattern || h->limited))
-            mutt_uncollapse_thread(ctx, h);
-        }
+        struct Header *h = save_new[i];
+        if (!ctx->pattern || h->limited)
+          mutt_uncollapse_thread(ctx, h);
       }
       FREE(&save_new);
       mutt_set_virtual(ctx);
@@ -591,6 +587,161 @@ void mutt_ts_icon(char *str)
   fprintf(stderr, "\033]1;%s\007", str);
 }
 
+#define ROW_CACHE_SIZE 256 /**< Number of rendered index rows to keep */
+
+/**
+ * struct RowCache - A rendered row of the index
+ */
+struct RowCache
+{
+  unsigned int generation; /**< Value of RowCacheGen when rendered, 0 if unused */
+  struct Header *h;        /**< Message */
+  struct Header hdr;       /**< Copy of the message's header, to detect changes */
+  char *tree;              /**< Copy of the message's thread tree */
+  int num;                 /**< Virtual message number */
+  int flags;               /**< Format flags */
+  int cols;                /**< Width of the index window */
+  char *text;              /**< Rendered row */
+};
+
+static struct RowCache RowCacheEntries[ROW_CACHE_SIZE];
+static unsigned int RowCacheGen = 1;      /* bumped when rows may have changed */
+static struct Menu *RowCacheMenu = NULL;  /* the index menu using the cache */
+static char *RowCacheFormat = NULL;       /* $index_format the analysis is for */
+static bool RowCacheFormatCacheable = false;
+
+/**
+ * row_cache_invalidate - Forget all the rendered index rows
+ */
+static void row_cache_invalidate(void)
+{
+  RowCacheGen++;
+  if (RowCacheGen == 0)
+    RowCacheGen = 1;
+}
+
+/**
+ * row_cache_format_ok - Can rows rendered with $index_format be reused?
+ * @retval true If the format only depends on the message
+ *
+ * The analysis is done once for each value of $index_format.  Formats using
+ * the current time (%<...> and the %?[ and %?( conditionals) or an external
+ * filter can't be cached.
+ */
+static bool row_cache_format_ok(void)
+{
+  const char *fmt = NONULL(IndexFormat);
+
+  if (RowCacheFormat && (mutt_strcmp(RowCacheFormat, fmt) == 0))
+    return RowCacheFormatCacheable;
+
+  mutt_str_replace(&RowCacheFormat, fmt);
+  RowCacheFormatCacheable = true;
+
+  size_t len = strlen(fmt);
+  if (len && (fmt[len - 1] == '|'))
+    RowCacheFormatCacheable = false;
+
+  for (const char *p = strchr(fmt, '%'); p && RowCacheFormatCacheable; p = strchr(p, '%'))
+  {
+    bool optional = false;
+    p++;
+    if (*p == '%')
+    {
+      p++;
+      continue;
+    }
+    if (*p == '?')
+    {
+      optional = true;
+      p++;
+    }
+    p += strspn(p, "-=0123456789.>_:");
+    if ((*p == '<') || (optional && ((*p == '[') || (*p == '('))))
+      RowCacheFormatCacheable = false;
+  }
+
+  return RowCacheFormatCacheable;
+}
+
+/**
+ * row_cache_keeps - Does an operation leave the rendered index rows valid?
+ * @param op Operation, e.g. OP_NEXT_PAGE
+ * @retval true If the operation only moves around the index
+ */
+static bool row_cache_keeps(int op)
+{
+  switch (op)
+  {
+    case OP_BOTTOM_PAGE:
+    case OP_FIRST_ENTRY:
+    case OP_MIDDLE_PAGE:
+    case OP_HALF_UP:
+    case OP_HALF_DOWN:
+    case OP_NEXT_LINE:
+    case OP_PREV_LINE:
+    case OP_NEXT_PAGE:
+    case OP_PREV_PAGE:
+    case OP_LAST_ENTRY:
+    case OP_TOP_PAGE:
+    case OP_CURRENT_TOP:
+    case OP_CURRENT_MIDDLE:
+    case OP_CURRENT_BOTTOM:
+    case OP_JUMP:
+    case OP_NEXT_ENTRY:
+    case OP_PREV_ENTRY:
+    case OP_MAIN_NEXT_UNDELETED:
+    case OP_MAIN_PREV_UNDELETED:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * row_cache_lookup - Find a rendered index row
+ * @param h     Message
+ * @param num   Virtual message number
+ * @param flags Format flags
+ * @retval ptr  Cache entry for the row, if it's still valid
+ * @retval NULL Otherwise
+ */
+static struct RowCache *row_cache_lookup(struct Header *h, int num, int flags)
+{
+  struct RowCache *rc = &RowCacheEntries[num % ROW_CACHE_SIZE];
+
+  if ((rc->generation != RowCacheGen) || (rc->h != h) || (rc->num != num) ||
+      (rc->flags != flags) || (rc->cols != MuttIndexWindow->cols) ||
+      (memcmp(&rc->hdr, h, sizeof(struct Header)) != 0) ||
+      (mutt_strcmp(rc->tree, h->tree) != 0))
+  {
+    return NULL;
+  }
+
+  return rc;
+}
+
+/**
+ * row_cache_store - Save a rendered index row
+ * @param h     Message
+ * @param num   Virtual message number
+ * @param flags Format flags
+ * @param text  Rendered row
+ */
+static void row_cache_store(struct Header *h, int num, int flags, const char *text)
+{
+  struct RowCache *rc = &RowCacheEntries[num % ROW_CACHE_SIZE];
+
+  rc->generation = RowCacheGen;
+  rc->h = h;
+  memcpy(&rc->hdr, h, sizeof(struct Header));
+  mutt_str_replace(&rc->tree, h->tree);
+  rc->num = num;
+  rc->flags = flags;
+  rc->cols = MuttIndexWindow->cols;
+  mutt_str_replace(&rc->text, text);
+}
+
 void index_make_entry(char *s, size_t l, struct Menu *menu, int num)
 {
   if (!Context || !menu || (num < 0) || (num >= Context->hdrmax))
@@ -656,7 +807,21 @@ void index_make_entry(char *s, size_t l, struct Menu *menu, int num)
     }
   }
 
+  bool cacheable = (menu == RowCacheMenu) && row_cache_format_ok();
+  if (cacheable)
+  {
+    struct RowCache *rc = row_cache_lookup(h, num, flag);
+    if (rc)
+    {
+      strfcpy(s, rc->text, l);
+      return;
+    }
+  }
+
   _mutt_make_string(s, l, NONULL(IndexFormat), Context, h, flag);
+
+  if (cacheable)
+    row_cache_store(h, num, flag, s);
 }
 
 int index_color(int index_no)
@@ -913,6 +1078,7 @@ int mutt_index_menu(void)
   bool do_buffy_notify = true;
   int close = 0; /* did we OP_QUIT or OP_EXIT out of this menu? */
   int attach_msg = option(OPT_ATTACH_MSG);
+  struct Menu *old_row_cache_menu = RowCacheMenu;
 
   menu = mutt_new_menu(MENU_MAIN);
   menu->make_entry = index_make_entry;
@@ -926,6 +1092,8 @@ int mutt_index_menu(void)
                                                                      IndexHelp);
   menu->custom_menu_redraw = index_menu_redraw;
   mutt_push_current_menu(menu);
+  RowCacheMenu = menu;
+  row_cache_invalidate();
 
   if (!attach_msg)
     mutt_buffy_check(true); /* force the buffy check after we enter the folder */
@@ -957,6 +1125,7 @@ int mutt_index_menu(void)
     if (option(OPT_REDRAW_TREE) && Context && Context->msgcount && (Sort & SORT_MASK) == SORT_THREADS)
     {
       mutt_draw_tree(Context);
+      row_cache_invalidate();
       menu->redraw |= REDRAW_STATUS;
       unset_option(OPT_REDRAW_TREE);
     }
@@ -1020,6 +1189,7 @@ int mutt_index_menu(void)
         /* avoid the message being overwritten by buffy */
         do_buffy_notify = false;
 
+        row_cache_invalidate();
         bool q = Context->quiet;
         Context->quiet = true;
         update_index(menu, Context, check, oldcount, index_hint);
@@ -1109,6 +1279,7 @@ int mutt_index_menu(void)
       /* either user abort or timeout */
       if (op < 0)
       {
+        row_cache_invalidate();
         mutt_timeout_hook();
         if (tag)
           mutt_window_clearline(MuttMessageWindow, 0);
@@ -1165,6 +1336,10 @@ int mutt_index_menu(void)
       mutt_curs_set(1); /* fallback from the pager */
     }
 
+    /* anything but moving around the index may change the rows */
+    if ((menu->menu != MENU_MAIN) || !row_cache_keeps(op))
+      row_cache_invalidate();
+
 #ifdef USE_NNTP
     unset_option(OPT_NEWS); /* for any case */
 #endif
@@ -3316,22 +3491,21 @@ int mutt_index_menu(void)
 
   mutt_pop_current_menu(menu);
   mutt_menu_destroy(&menu);
+  RowCacheMenu = old_row_cache_menu;
+  row_cache_invalidate();
   return close;
 }
 
 void mutt_set_header_color(struct Context *ctx, struct Header *curhdr)
 {
   struct ColorLine *color = NULL;
-  struct PatternCache cache;
 
   if (!curhdr)
     return;
 
-  memset(&cache, 0, sizeof(cache));
-
   STAILQ_FOREACH(color, &ColorIndexList, entries)
   {
-    if (mutt_pattern_exec(color->color_pattern, MUTT_MATCH_FULL_ADDRESS, ctx, curhdr, &cache))
+    if (mutt_pattern_exec(color->color_pattern, MUTT_MATCH_FULL_ADDRESS, ctx, curhdr))
     {
       curhdr->pair = color->pair;
       return;
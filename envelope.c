@@ -23,14 +23,18 @@
 #include "config.h"
 #include <stddef.h>
 #include "lib/buffer.h"
+#include "lib/intern.h"
 #include "lib/memory.h"
+#include "lib/pool.h"
 #include "envelope.h"
 #include "queue.h"
 #include "rfc822.h"
 
+static struct Pool EnvelopePool = POOL_INITIALIZER(struct Envelope);
+
 struct Envelope *mutt_new_envelope(void)
 {
-  struct Envelope *e = safe_calloc(1, sizeof(struct Envelope));
+  struct Envelope *e = mutt_pool_alloc(&EnvelopePool);
   STAILQ_INIT(&e->references);
   STAILQ_INIT(&e->in_reply_to);
   STAILQ_INIT(&e->userhdrs);
@@ -50,15 +54,15 @@ void mutt_free_envelope(struct Envelope **p)
   rfc822_free_address(&(*p)->reply_to);
   rfc822_free_address(&(*p)->mail_followup_to);
 
-  FREE(&(*p)->list_post);
+  mutt_str_unintern(&(*p)->list_post);
   FREE(&(*p)->subject);
   /* real_subj is just an offset to subject and shouldn't be freed */
   FREE(&(*p)->disp_subj);
   FREE(&(*p)->message_id);
   FREE(&(*p)->supersedes);
   FREE(&(*p)->date);
-  FREE(&(*p)->x_label);
-  FREE(&(*p)->organization);
+  mutt_str_unintern(&(*p)->x_label);
+  mutt_str_unintern(&(*p)->organization);
 #ifdef USE_NNTP
   FREE(&(*p)->newsgroups);
   FREE(&(*p)->xref);
@@ -71,7 +75,7 @@ void mutt_free_envelope(struct Envelope **p)
   mutt_list_free(&(*p)->references);
   mutt_list_free(&(*p)->in_reply_to);
   mutt_list_free(&(*p)->userhdrs);
-  FREE(p);
+  mutt_pool_free(&EnvelopePool, p);
 }
 
 /**
@@ -314,7 +314,10 @@ void _mutt_set_flag(struct Context *ctx, struct Header *h, int flag, int bf, int
 
   if (update)
   {
-    mutt_set_header_color(ctx, h);
+    /* Recolour the message when it's next drawn.  Changing many flags at
+     * once, e.g. tagging a pattern, then only evaluates the colour rules for
+     * the messages that are visible. */
+    h->pair = 0;
 #ifdef USE_SIDEBAR
     mutt_set_current_menu_redraw(REDRAW_SIDEBAR);
 #endif
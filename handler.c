@@ -168,221 +168,227 @@ static void decode_xbit(struct State *s, long len, int istext, iconv_t cd)
     mutt_copy_bytes(s->fpin, s->fpout, len);
 }
 
-static int qp_decode_triple(char *s, char *d)
+/**
+ * qp_decode_line - Decode one line of quoted-printable text
+ * @param dest Buffer for the result, at least n+1 bytes
+ * @param src  Encoded text, without the line terminator
+ * @param n    Length of the encoded text
+ * @param eol  true if the text is a whole line, ending in a newline
+ * @retval num Number of bytes written to dest
+ *
+ * The literal runs between '=' escapes are copied in one go.
+ */
+static size_t qp_decode_line(char *dest, const char *src, size_t n, bool eol)
 {
-  /* soft line break */
-  if (*s == '=' && !(*(s + 1)))
-    return 1;
+  const char *s = src;
+  const char *end = src + n;
+  char *d = dest;
+  bool soft = false;
+  bool cr = false; /* the line ended with an encoded '\r' */
 
-  /* quoted-printable triple */
-  if (*s == '=' && isxdigit((unsigned char) *(s + 1)) &&
-      isxdigit((unsigned char) *(s + 2)))
+  /* chop trailing whitespace if we got the full line */
+  if (eol)
   {
-    *d = (hexval(*(s + 1)) << 4) | hexval(*(s + 2));
-    return 0;
+    while ((end > s) && ISSPACE(end[-1]))
+      end--;
   }
 
-  /* something else */
-  return -1;
-}
-
-static void qp_decode_line(char *dest, char *src, size_t *l, int last)
-{
-  char *d = NULL, *s = NULL;
-  char c = 0;
-
-  int kind = -1;
-  bool soft = false;
+  while (s < end)
+  {
+    const char *eq = memchr(s, '=', end - s);
+    if (!eq)
+      eq = end;
 
-  /* decode the line */
+    if (eq > s)
+    {
+      memcpy(d, s, eq - s);
+      d += eq - s;
+      s = eq;
+      cr = false;
+      continue;
+    }
 
-  for (d = dest, s = src; *s;)
-  {
-    switch ((kind = qp_decode_triple(s, &c)))
+    if (s + 1 == end)
+    {
+      /* soft line break */
+      soft = true;
+      s++;
+    }
+    else if ((s + 2 < end) && isxdigit((unsigned char) s[1]) &&
+             isxdigit((unsigned char) s[2]))
+    {
+      /* quoted-printable triple */
+      *d = (hexval(s[1]) << 4) | hexval(s[2]);
+      cr = (*d++ == '\r');
+      s += 3;
+    }
+    else
     {
-      case 0:
-        *d++ = c;
-        s += 3;
-        break; /* qp triple */
-      case -1:
-        *d++ = *s++;
-        break; /* single character */
-      case 1:
-        soft = true;
-        s++;
-        break; /* soft line break */
+      /* something else */
+      *d++ = *s++;
+      cr = false;
     }
   }
 
-  if (!soft && last == '\n')
+  if (!soft && eol)
   {
     /* neither \r nor \n as part of line-terminating CRLF
      * may be qp-encoded, so remove \r and \n-terminate;
      * see RfC2045, sect. 6.7, (1): General 8bit representation */
-    if (kind == 0 && c == '\r')
+    if (cr)
       *(d - 1) = '\n';
     else
       *d++ = '\n';
   }
 
-  *d = '\0';
-  *l = d - dest;
+  return d - dest;
 }
 
 /**
  * decode_quoted - Decode an attachment encoded with quoted-printable
  *
- * Why doesn't this overflow any buffers?  First, it's guaranteed that the
- * length of a line grows when you _en_-code it to quoted-printable.  That
- * means that we always can store the result in a buffer of at most the _same_
- * size.
+ * The input is read in large blocks and split into lines with memchr().
+ * Decoding never makes a line longer (apart from its newline), so the decoded
+ * text is collected in bufi and only handed to convert_to_state() when it's
+ * nearly full.
  *
- * Now, we don't special-case if the line we read with fgets() isn't
- * terminated.  We don't care about this, since STRING > 78, so corrupted input
- * will just be corrupted a bit more.  That implies that STRING+1 bytes are
- * always sufficient to store the result of qp_decode_line.
- *
- * Finally, at soft line breaks, some part of a multibyte character may have
- * been left over by convert_to_state().  This shouldn't be more than 6
- * characters, so STRING + 7 should be sufficient memory to store the decoded
- * data.
- *
- * Just to make sure that I didn't make some off-by-one error above, we just
- * use STRING*2 for the target buffer's size.
+ * Q-P encoded lines should be at most 76 characters, but we accept longer
+ * ones.  A line that doesn't fit in the input block is decoded in pieces,
+ * taking care not to split an '=' escape between them.
  */
 static void decode_quoted(struct State *s, long len, int istext, iconv_t cd)
 {
-  char line[STRING];
-  char decline[2 * STRING];
+  char in[8192];
+  char bufi[sizeof(in) + STRING];
+  size_t ilen = 0; /* number of undecoded bytes in `in' */
   size_t l = 0;
-  size_t linelen; /* number of input bytes in `line' */
-  size_t l3;
-
-  int last; /* store the last character in the input line */
 
   if (istext)
     state_set_prefix(s);
 
-  while (len > 0)
+  while (true)
   {
-    last = 0;
-
-    /*
-     * It's ok to use a fixed size buffer for input, even if the line turns
-     * out to be longer than this.  Just process the line in chunks.  This
-     * really shouldn't happen according the MIME spec, since Q-P encoded
-     * lines are at most 76 characters, but we should be liberal about what
-     * we accept.
-     */
-    if (fgets(line, MIN((ssize_t) sizeof(line), len + 1), s->fpin) == NULL)
-      break;
-
-    linelen = strlen(line);
-    len -= linelen;
+    size_t n = 0;
+    if (len > 0)
+      n = fread(in + ilen, 1, MIN(len, (long) (sizeof(in) - ilen)), s->fpin);
+    len -= n;
+    ilen += n;
+
+    char *p = in;
+    char *end = in + ilen;
+    char *nl = NULL;
+    size_t seg;
+
+    while ((nl = memchr(p, '\n', end - p)))
+    {
+      seg = nl - p;
+      if ((l + seg + 1) > sizeof(bufi))
+        convert_to_state(cd, bufi, &l, s);
+      l += qp_decode_line(bufi + l, p, seg, true);
+      p = nl + 1;
+    }
 
-    /*
-     * inspect the last character we read so we can tell if we got the
-     * entire line.
-     */
-    last = linelen ? line[linelen - 1] : 0;
+    seg = end - p;
+    if (n == 0)
+    {
+      /* the input ended without a newline */
+      if (seg > 0)
+      {
+        if ((l + seg + 1) > sizeof(bufi))
+          convert_to_state(cd, bufi, &l, s);
+        l += qp_decode_line(bufi + l, p, seg, false);
+      }
+      break;
+    }
 
-    /* chop trailing whitespace if we got the full line */
-    if (last == '\n')
+    if (seg == sizeof(in))
     {
-      while (linelen > 0 && ISSPACE(line[linelen - 1]))
-        linelen--;
-      line[linelen] = '\0';
+      /* the line is longer than the block; keep a trailing escape for later */
+      size_t keep = 0;
+      if (p[seg - 1] == '=')
+        keep = 1;
+      else if (p[seg - 2] == '=')
+        keep = 2;
+
+      if ((l + seg + 1) > sizeof(bufi))
+        convert_to_state(cd, bufi, &l, s);
+      l += qp_decode_line(bufi + l, p, seg - keep, false);
+      p += seg - keep;
+      seg = keep;
     }
 
-    /* decode and do character set conversion */
-    qp_decode_line(decline + l, line, &l3, last);
-    l += l3;
-    convert_to_state(cd, decline, &l, s);
+    memmove(in, p, seg);
+    ilen = seg;
   }
 
+  convert_to_state(cd, bufi, &l, s);
   convert_to_state(cd, 0, 0, s);
   state_reset_prefix(s);
 }
 
 void mutt_decode_base64(struct State *s, long len, int istext, iconv_t cd)
 {
-  char buf[5];
-  int c1, c2, c3, c4, ch, cr = 0, i;
-  char bufi[BUFI_SIZE];
+  struct Base64Decoder dec;
+  char in[8192];
+  char out[sizeof(in) / 4 * 3 + 3];
+  char bufi[8192];
   size_t l = 0;
+  bool cr = false;
 
-  buf[4] = '\0';
+  mutt_b64_decoder_init(&dec);
 
   if (istext)
     state_set_prefix(s);
 
-  while (len > 0)
+  /* Decode large blocks at a time; the decoder keeps any incomplete group of
+   * characters between blocks */
+  while ((len > 0) && !dec.done)
   {
-    for (i = 0; i < 4 && len > 0; len--)
-    {
-      ch = fgetc(s->fpin);
-      if (ch == EOF)
-        break;
-      if (ch >= 0 && ch < 128 && (base64val(ch) != -1 || ch == '='))
-        buf[i++] = ch;
-    }
-    if (i != 4)
-    {
-      /* "i" may be zero if there is trailing whitespace, which is not an error */
-      if (i != 0)
-        mutt_debug(2, "%s:%d [mutt_decode_base64()]: "
-                      "didn't get a multiple of 4 chars.\n",
-                   __FILE__, __LINE__);
+    size_t n = fread(in, 1, MIN(len, (long) sizeof(in)), s->fpin);
+    if (n == 0)
       break;
-    }
-
-    c1 = base64val(buf[0]);
-    c2 = base64val(buf[1]);
-    ch = (c1 << 2) | (c2 >> 4);
+    len -= n;
 
-    if (cr && ch != '\n')
-      bufi[l++] = '\r';
+    size_t olen = mutt_b64_decode_block(&dec, in, n, out);
 
-    cr = 0;
-
-    if (istext && ch == '\r')
-      cr = 1;
-    else
-      bufi[l++] = ch;
-
-    if (buf[2] == '=')
-      break;
-    c3 = base64val(buf[2]);
-    ch = ((c2 & 0xf) << 4) | (c3 >> 2);
-
-    if (cr && ch != '\n')
-      bufi[l++] = '\r';
-
-    cr = 0;
-
-    if (istext && ch == '\r')
-      cr = 1;
-    else
-      bufi[l++] = ch;
+    if (!istext)
+    {
+      for (size_t off = 0; off < olen;)
+      {
+        size_t chunk = MIN(olen - off, sizeof(bufi) - l);
+        memcpy(bufi + l, out + off, chunk);
+        l += chunk;
+        off += chunk;
+        if (l == sizeof(bufi))
+          convert_to_state(cd, bufi, &l, s);
+      }
+      continue;
+    }
 
-    if (buf[3] == '=')
-      break;
-    c4 = base64val(buf[3]);
-    ch = ((c3 & 0x3) << 6) | c4;
+    /* Text: convert CRLF to LF, even if the pair is split between blocks */
+    for (size_t i = 0; i < olen; i++)
+    {
+      if (l + 2 > sizeof(bufi))
+        convert_to_state(cd, bufi, &l, s);
 
-    if (cr && ch != '\n')
-      bufi[l++] = '\r';
-    cr = 0;
+      if (cr && (out[i] != '\n'))
+        bufi[l++] = '\r';
 
-    if (istext && ch == '\r')
-      cr = 1;
-    else
-      bufi[l++] = ch;
+      cr = false;
 
-    if (l + 8 >= sizeof(bufi))
-      convert_to_state(cd, bufi, &l, s);
+      if (out[i] == '\r')
+        cr = true;
+      else
+        bufi[l++] = out[i];
+    }
   }
 
+  /* "count" may be zero if there is trailing whitespace, which is not an error */
+  if (!dec.done && (dec.count != 0))
+    mutt_debug(2, "%s:%d [mutt_decode_base64()]: "
+                  "didn't get a multiple of 4 chars.\n",
+               __FILE__, __LINE__);
+
   if (cr)
     bufi[l++] = '\r';
 
@@ -1649,7 +1655,7 @@ void mutt_decode_attachment(struct Body *b, struct State *s)
   }
 
   if (cd != (iconv_t)(-1))
-    iconv_close(cd);
+    mutt_iconv_close(cd);
 }
 
 /**
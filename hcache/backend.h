@@ -47,10 +47,11 @@ typedef void *(*hcache_open_t)(const char *path);
  * @param ctx    The backend-specific context retrieved via hcache_open
  * @param key    A message identification string
  * @param keylen The length of the string pointed to by key
+ * @param dlen   If not NULL, set to the length of the data found
  * @retval Pointer to the message's headers on success
  * @retval NULL otherwise
  */
-typedef void *(*hcache_fetch_t)(void *ctx, const char *key, size_t keylen);
+typedef void *(*hcache_fetch_t)(void *ctx, const char *key, size_t keylen, size_t *dlen);
 
 /**
  * hcache_free_t - backend-specific routine to free fetched data
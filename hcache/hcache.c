@@ -247,6 +247,15 @@ static void restore_char(char **c, const unsigned char *d, int *off, bool conver
   *off += size;
 }
 
+static void restore_intern(char **c, const unsigned char *d, int *off, bool convert)
+{
+  char *tmp = NULL;
+
+  restore_char(&tmp, d, off, convert);
+  *c = mutt_str_intern(tmp);
+  FREE(&tmp);
+}
+
 static unsigned char *dump_address(struct Address *a, unsigned char *d, int *off, bool convert)
 {
   unsigned int counter = 0;
@@ -499,7 +508,7 @@ static void restore_envelope(struct Envelope *e, const unsigned char *d, int *of
   restore_address(&e->reply_to, d, off, convert);
   restore_address(&e->mail_followup_to, d, off, convert);
 
-  restore_char(&e->list_post, d, off, convert);
+  restore_intern(&e->list_post, d, off, convert);
   restore_char(&e->subject, d, off, convert);
   restore_int((unsigned int *) (&real_subj_off), d, off);
 
@@ -511,7 +520,7 @@ static void restore_envelope(struct Envelope *e, const unsigned char *d, int *of
   restore_char(&e->message_id, d, off, false);
   restore_char(&e->supersedes, d, off, false);
   restore_char(&e->date, d, off, false);
-  restore_char(&e->x_label, d, off, convert);
+  restore_intern(&e->x_label, d, off, convert);
 
   restore_buffer(&e->spam, d, off, convert);
 
@@ -682,6 +691,9 @@ static void *hcache_dump(header_cache_t *h, struct Header *header, int *off,
   nh.num_hidden = 0;
   nh.recipient = 0;
   nh.pair = 0;
+  nh.memo_gen = 0;
+  nh.memo = NULL;
+  nh.memo_len = 0;
   nh.attach_valid = false;
   nh.path = NULL;
   nh.tree = NULL;
@@ -852,6 +864,12 @@ void *mutt_hcache_fetch(header_cache_t *h, const char *key, size_t keylen)
 }
 
 void *mutt_hcache_fetch_raw(header_cache_t *h, const char *key, size_t keylen)
+{
+  return mutt_hcache_fetch_raw_len(h, key, keylen, NULL);
+}
+
+void *mutt_hcache_fetch_raw_len(header_cache_t *h, const char *key,
+                                size_t keylen, size_t *dlen)
 {
   char path[_POSIX_PATH_MAX];
   const struct HcacheOps *ops = hcache_get_ops();
@@ -861,7 +879,7 @@ void *mutt_hcache_fetch_raw(header_cache_t *h, const char *key, size_t keylen)
 
   keylen = snprintf(path, sizeof(path), "%s%s", h->folder, key);
 
-  return ops->fetch(h->ctx, path, keylen);
+  return ops->fetch(h->ctx, path, keylen, dlen);
 }
 
 void mutt_hcache_free(header_cache_t *h, void **data)
@@ -96,6 +96,20 @@ void *mutt_hcache_fetch(header_cache_t *h, const char *key, size_t keylen);
  */
 void *mutt_hcache_fetch_raw(header_cache_t *h, const char *key, size_t keylen);
 
+/**
+ * mutt_hcache_fetch_raw_len - fetch data and its length from the cache
+ * @param h      Pointer to the header_cache_t structure got by mutt_hcache_open
+ * @param key    Message identification string
+ * @param keylen Length of the string pointed to by key
+ * @param dlen   If not NULL, set to the length of the data found
+ * @retval Pointer to the data if found
+ * @retval NULL otherwise
+ * @note Like mutt_hcache_fetch_raw, but lets the caller check the size of
+ *       the data before trusting its contents.
+ */
+void *mutt_hcache_fetch_raw_len(header_cache_t *h, const char *key,
+                                size_t keylen, size_t *dlen);
+
 /**
  * mutt_hcache_free - free previously fetched data
  * @param h    Pointer to the header_cache_t structure got by mutt_hcache_open
@@ -68,7 +68,8 @@ static void *hcache_kyotocabinet_open(const char *path)
   }
 }
 
-static void *hcache_kyotocabinet_fetch(void *ctx, const char *key, size_t keylen)
+static void *hcache_kyotocabinet_fetch(void *ctx, const char *key, size_t keylen,
+                                       size_t *dlen)
 {
   size_t sp;
 
@@ -76,7 +77,10 @@ static void *hcache_kyotocabinet_fetch(void *ctx, const char *key, size_t keylen
     return NULL;
 
   KCDB *db = ctx;
-  return kcdbget(db, key, keylen, &sp);
+  void *data = kcdbget(db, key, keylen, &sp);
+  if (dlen)
+    *dlen = sp;
+  return data;
 }
 
 static void hcache_kyotocabinet_free(void *vctx, void **data)
@@ -158,7 +158,7 @@ fail_env:
   return NULL;
 }
 
-static void *hcache_lmdb_fetch(void *vctx, const char *key, size_t keylen)
+static void *hcache_lmdb_fetch(void *vctx, const char *key, size_t keylen, size_t *dlen)
 {
   MDB_val dkey;
   MDB_val data;
@@ -191,6 +191,8 @@ static void *hcache_lmdb_fetch(void *vctx, const char *key, size_t keylen)
     return NULL;
   }
 
+  if (dlen)
+    *dlen = data.mv_size;
   return data.mv_data;
 }
 
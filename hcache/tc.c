@@ -59,7 +59,8 @@ static void *hcache_tokyocabinet_open(const char *path)
   }
 }
 
-static void *hcache_tokyocabinet_fetch(void *ctx, const char *key, size_t keylen)
+static void *hcache_tokyocabinet_fetch(void *ctx, const char *key, size_t keylen,
+                                       size_t *dlen)
 {
   int sp;
 
@@ -67,7 +68,10 @@ static void *hcache_tokyocabinet_fetch(void *ctx, const char *key, size_t keylen
     return NULL;
 
   TCBDB *db = ctx;
-  return tcbdbget(db, key, keylen, &sp);
+  void *data = tcbdbget(db, key, keylen, &sp);
+  if (dlen)
+    *dlen = sp;
+  return data;
 }
 
 static void hcache_tokyocabinet_free(void *ctx, void **data)
@@ -1227,7 +1227,8 @@ static const char *hdr_format_str(char *dest, size_t destlen, size_t col, int co
                  (hdr->thread->parent && hdr->thread->parent->message &&
                   hdr->thread->parent->message->env->x_label))
           htmp = hdr->thread->parent->message;
-        if (htmp && (mutt_strcasecmp(hdr->env->x_label, htmp->env->x_label) == 0))
+        if (htmp && ((hdr->env->x_label == htmp->env->x_label) ||
+                     (mutt_strcasecmp(hdr->env->x_label, htmp->env->x_label) == 0)))
           i = 0;
       }
       else
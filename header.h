@@ -83,6 +83,10 @@ struct Header
 
   int pair;           /**< color-pair to use when displaying in the index */
 
+  unsigned int memo_gen; /**< generation of the memoized pattern results */
+  unsigned char *memo;   /**< memoized pattern results, see mutt_pattern_exec() */
+  size_t memo_len;       /**< size of the memo array */
+
   time_t date_sent;   /**< time when the message was sent (UTC) */
   time_t received;    /**< time when the message was placed in the mailbox */
   LOFF_T offset;      /**< where in the stream does this message begin? */
@@ -119,14 +123,6 @@ struct Header
   char *maildir_flags; /**< unknown maildir flags */
 };
 
-static inline struct Header *mutt_new_header(void)
-{
-  struct Header *h = safe_calloc(1, sizeof(struct Header));
-#ifdef MIXMASTER
-  STAILQ_INIT(&h->chain);
-#endif
-  STAILQ_INIT(&h->tags);
-  return h;
-}
+struct Header *mutt_new_header(void);
 
 #endif /* _MUTT_HEADER_H */
@@ -40,6 +40,7 @@
 #include "mutt_idna.h"
 #include "ncrypt/ncrypt.h"
 #include "options.h"
+#include "pattern.h"
 #include "protos.h"
 
 void mutt_edit_headers(const char *editor, const char *body, struct Header *msg,
@@ -274,9 +275,11 @@ static int label_message(struct Context *ctx, struct Header *hdr, char *new)
 
   if (hdr->env->x_label)
     label_ref_dec(ctx, hdr->env->x_label);
-  mutt_str_replace(&hdr->env->x_label, new);
+  mutt_str_unintern(&hdr->env->x_label);
+  hdr->env->x_label = mutt_str_intern(new);
   if (hdr->env->x_label)
     label_ref_inc(ctx, hdr->env->x_label);
+  mutt_pattern_memo_invalidate(hdr);
 
   return hdr->changed = hdr->xlabel_changed = true;
 }
@@ -219,9 +219,13 @@ int mutt_parse_hook(struct Buffer *buf, struct Buffer *s, unsigned long data,
   if (data & (MUTT_SENDHOOK | MUTT_SEND2HOOK | MUTT_SAVEHOOK | MUTT_FCCHOOK |
               MUTT_MESSAGEHOOK | MUTT_REPLYHOOK))
   {
-    if ((pat = mutt_pattern_comp(
-             pattern.data, (data & (MUTT_SENDHOOK | MUTT_SEND2HOOK | MUTT_FCCHOOK)) ? 0 : MUTT_FULL_MSG,
-             err)) == NULL)
+    /* Send hooks match messages that are still being edited,
+     * so their results mustn't be memoized */
+    if ((pat = mutt_pattern_comp(pattern.data,
+                                 (data & (MUTT_SENDHOOK | MUTT_SEND2HOOK | MUTT_FCCHOOK)) ?
+                                     0 :
+                                     MUTT_FULL_MSG | MUTT_PATTERN_MEMO,
+                                 err)) == NULL)
       goto error;
   }
   else if (~data & MUTT_GLOBALHOOK) /* NOT a global hook */
@@ -387,7 +391,6 @@ void mutt_message_hook(struct Context *ctx, struct Header *hdr, int type)
 {
   struct Buffer err, token;
   struct Hook *hook = NULL;
-  struct PatternCache cache;
 
   current_hook_type = type;
 
@@ -395,14 +398,13 @@ void mutt_message_hook(struct Context *ctx, struct Header *hdr, int type)
   err.dsize = STRING;
   err.data = safe_malloc(err.dsize);
   mutt_buffer_init(&token);
-  memset(&cache, 0, sizeof(cache));
   TAILQ_FOREACH(hook, &Hooks, entries)
   {
     if (!hook->command)
       continue;
 
     if (hook->type & type)
-      if ((mutt_pattern_exec(hook->pattern, 0, ctx, hdr, &cache) > 0) ^
+      if ((mutt_pattern_exec(hook->pattern, 0, ctx, hdr) > 0) ^
           hook->regex.not)
       {
         if (mutt_parse_rc_line(hook->command, &token, &err) == -1)
@@ -416,8 +418,7 @@ void mutt_message_hook(struct Context *ctx, struct Header *hdr, int type)
           return;
         }
         /* Executing arbitrary commands could affect the pattern results,
-         * so the cache has to be wiped */
-        memset(&cache, 0, sizeof(cache));
+         * so mutt_parse_rc_line() wipes the memoized results */
       }
   }
   FREE(&token.data);
@@ -430,9 +431,7 @@ static int addr_hook(char *path, size_t pathlen, int type, struct Context *ctx,
                      struct Header *hdr)
 {
   struct Hook *hook = NULL;
-  struct PatternCache cache;
 
-  memset(&cache, 0, sizeof(cache));
   /* determine if a matching hook exists */
   TAILQ_FOREACH(hook, &Hooks, entries)
   {
@@ -440,7 +439,7 @@ static int addr_hook(char *path, size_t pathlen, int type, struct Context *ctx,
       continue;
 
     if (hook->type & type)
-      if ((mutt_pattern_exec(hook->pattern, 0, ctx, hdr, &cache) > 0) ^
+      if ((mutt_pattern_exec(hook->pattern, 0, ctx, hdr) > 0) ^
           hook->regex.not)
       {
         mutt_make_string(path, pathlen, hook->command, ctx, hdr);
@@ -49,6 +49,7 @@
 #include "mutt_tags.h"
 #include "mx.h"
 #include "options.h"
+#include "pattern.h"
 #include "protos.h"
 #ifdef USE_HCACHE
 #include "hcache/hcache.h"
@@ -1032,6 +1033,7 @@ parsemsg:
   read = h->read;
   newenv = mutt_read_rfc822_header(msg->fp, h, 0, 0);
   mutt_merge_envelopes(h->env, &newenv);
+  mutt_pattern_memo_invalidate(h);
 
   /* see above. We want the new status in h->read, so we unset it manually
    * and let mutt_set_flag set it correctly, updating context. */
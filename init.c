@@ -3319,6 +3319,22 @@ static int parse_source(struct Buffer *tmp, struct Buffer *token,
   return 0;
 }
 
+/**
+ * affects_patterns - Can a command change the result of a pattern?
+ * @param cmd Command
+ * @retval true If memoized pattern results must be discarded
+ */
+static bool affects_patterns(const struct Command *cmd)
+{
+  return ((cmd->func == parse_set) || (cmd->func == parse_alternates) ||
+          (cmd->func == parse_unalternates) || (cmd->func == parse_lists) ||
+          (cmd->func == parse_unlists) || (cmd->func == parse_subscribe) ||
+          (cmd->func == parse_unsubscribe) || (cmd->func == parse_spam_list) ||
+          (cmd->func == parse_group) || (cmd->func == parse_alias) ||
+          (cmd->func == parse_unalias) || (cmd->func == parse_attachments) ||
+          (cmd->func == parse_unattachments) || (cmd->func == mutt_parse_hook));
+}
+
 /**
  * mutt_parse_rc_line - Parse a line of user config
  * @param line  config line to read
@@ -3360,6 +3376,8 @@ int mutt_parse_rc_line(/* const */ char *line, struct Buffer *token, struct Buff
       if (mutt_strcmp(token->data, Commands[i].name) == 0)
       {
         r = Commands[i].func(token, &expn, Commands[i].data, err);
+        if (affects_patterns(&Commands[i]))
+          mutt_pattern_memo_invalidate(NULL);
         if (r != 0)
         {              /* -1 Error, +1 Finish */
           goto finish; /* Propagate return code */
@@ -345,6 +345,21 @@ struct Option MuttVars[] = {
   ** notifying you of new mail.  This is independent of the setting of the
   ** $$beep variable.
   */
+#ifdef USE_HCACHE
+  { "body_index",       DT_BOOL, R_NONE, OPT_BODY_INDEX, 0 },
+  /*
+  ** .pp
+  ** When this variable is \fIset\fP, NeoMutt remembers a compact signature of
+  ** the text of each Maildir or MH message it searches with \fC~b\fP,
+  ** \fC~B\fP or \fC~h\fP, and stores it in the $$header_cache.  Later
+  ** searches for patterns that contain a literal string use the signatures
+  ** to skip messages that cannot match, without opening them.
+  ** .pp
+  ** The signatures only ever rule messages out, so the results of a search
+  ** are unchanged.  They take about two bits per byte of message text in the
+  ** header cache.
+  */
+#endif
   { "bounce",   DT_QUAD, R_NONE, OPT_BOUNCE, MUTT_ASKYES },
   /*
   ** .pp
@@ -4098,6 +4113,9 @@ struct Option MuttVars[] = {
   ** apart. This can improve throughput on systems with slow terminals,
   ** or when running NeoMutt on a remote system.
   ** .pp
+  ** Progress updates are never displayed more than 20 times a second,
+  ** even if $$time_inc is smaller than 50.
+  ** .pp
   ** Also see the ``$tuning'' section of the manual for performance considerations.
   */
   { "timeout",          DT_NUMBER,  R_NONE, UL &Timeout, 600 },
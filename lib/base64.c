@@ -34,16 +34,21 @@
  * | :----------------- | :--------------------------------------------------
  * | #Index_64          | Lookup table for Base64 encoding characters
  *
- * | Function           | Description
- * | :----------------- | :-------------------------------------------------
- * | mutt_from_base64() | convert null-terminated base64 string to raw bytes
- * | mutt_to_base64()   | convert raw bytes to null-terminated base64 string
+ * | Function                 | Description
+ * | :----------------------- | :-------------------------------------------
+ * | mutt_b64_decode_block()  | decode a block of a base64 stream
+ * | mutt_b64_decoder_init()  | start decoding a base64 stream
+ * | mutt_from_base64()       | convert null-terminated base64 string to raw bytes
+ * | mutt_to_base64()         | convert raw bytes to null-terminated base64 string
  */
 
 #include "config.h"
+#include <stdbool.h>
+#include <string.h>
 #include "base64.h"
 
 #define BAD -1
+#define PAD 64 /**< '=' in Base64Decoder.quad */
 
 static const char B64Chars[64] = {
   'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
@@ -170,3 +175,111 @@ int mutt_from_base64(char *out, const char *in)
 
   return len;
 }
+
+/**
+ * mutt_b64_decoder_init - start decoding a base64 stream
+ * @param dec Decoder state
+ */
+void mutt_b64_decoder_init(struct Base64Decoder *dec)
+{
+  memset(dec, 0, sizeof(*dec));
+}
+
+/**
+ * b64_decode_quad - decode a complete group of four characters
+ * @param[in]  quad Values of the characters, #PAD for '='
+ * @param[out] out  Output buffer, at least 3 bytes
+ * @param[out] done Set if the group contains padding
+ * @retval n Number of bytes written
+ *
+ * Padding in the first two positions isn't valid; like the original decoder
+ * in handler.c, it is treated as all bits set.
+ */
+static size_t b64_decode_quad(const unsigned char *quad, char *out, bool *done)
+{
+  int c1 = (quad[0] == PAD) ? BAD : quad[0];
+  int c2 = (quad[1] == PAD) ? BAD : quad[1];
+
+  out[0] = ((c1 < 0) ? 0xfc : (c1 << 2)) | ((c2 < 0) ? 0xff : (c2 >> 4));
+  if (quad[2] == PAD)
+  {
+    *done = true;
+    return 1;
+  }
+
+  out[1] = ((c2 & 0xf) << 4) | (quad[2] >> 2);
+  if (quad[3] == PAD)
+  {
+    *done = true;
+    return 2;
+  }
+
+  out[2] = ((quad[2] & 0x3) << 6) | quad[3];
+  return 3;
+}
+
+/**
+ * mutt_b64_decode_block - decode a block of a base64 stream
+ * @param dec   Decoder state, from mutt_b64_decoder_init()
+ * @param in    Base64 text
+ * @param inlen Length of the text
+ * @param out   Output buffer, at least (inlen / 4 * 3 + 3) bytes
+ * @retval n Number of bytes written to the output buffer
+ *
+ * Characters that aren't part of the base64 alphabet, such as line endings
+ * and whitespace, are skipped.  A group of four characters may be split
+ * across blocks.  Once padding ('=') ends a group, the rest of the stream is
+ * ignored and dec->done is set.
+ *
+ * Most of the text is made up of runs of complete groups, which are decoded
+ * four characters at a time, without looking at the decoder state.
+ */
+size_t mutt_b64_decode_block(struct Base64Decoder *dec, const char *in, size_t inlen, char *out)
+{
+  const unsigned char *p = (const unsigned char *) in;
+  const unsigned char *end = p + inlen;
+  char *o = out;
+
+  while (!dec->done && (p < end))
+  {
+    if (dec->count == 0)
+    {
+      while ((end - p) >= 4)
+      {
+        if ((p[0] | p[1] | p[2] | p[3]) & 0x80)
+          break;
+        int a = base64val(p[0]);
+        int b = base64val(p[1]);
+        int c = base64val(p[2]);
+        int d = base64val(p[3]);
+        if ((a | b | c | d) < 0)
+          break;
+        o[0] = (a << 2) | (b >> 4);
+        o[1] = (b << 4) | (c >> 2);
+        o[2] = (c << 6) | d;
+        o += 3;
+        p += 4;
+      }
+      if (p == end)
+        break;
+    }
+
+    unsigned char ch = *p++;
+    if (ch > 127)
+      continue;
+    if (ch == '=')
+      dec->quad[dec->count++] = PAD;
+    else if (base64val(ch) != BAD)
+      dec->quad[dec->count++] = base64val(ch);
+    else
+      continue;
+
+    if (dec->count == 4)
+    {
+      o += b64_decode_quad(dec->quad, o, &dec->done);
+      dec->count = 0;
+    }
+  }
+
+  return o - out;
+}
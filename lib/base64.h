@@ -21,13 +21,26 @@
 #ifndef _LIB_BASE64_H
 #define _LIB_BASE64_H
 
+#include <stdbool.h>
 #include <stdio.h>
 
 extern const int Index_64[];
 
 #define base64val(c) Index_64[(unsigned int) (c)]
 
+/**
+ * struct Base64Decoder - State of a streaming base64 decode
+ */
+struct Base64Decoder
+{
+  unsigned char quad[4]; /**< characters of an incomplete group */
+  int count;             /**< number of characters in quad */
+  bool done;             /**< padding has been seen; ignore further input */
+};
+
 size_t mutt_to_base64(char *out, const char *cin, size_t len, size_t olen);
 int mutt_from_base64(char *out, const char *in);
+void mutt_b64_decoder_init(struct Base64Decoder *dec);
+size_t mutt_b64_decode_block(struct Base64Decoder *dec, const char *in, size_t inlen, char *out);
 
 #endif /* _LIB_BASE64_H */
@@ -28,6 +28,7 @@
  *
  * | Function             | Description
  * | :------------------- | :--------------------------------------------------
+ * | mutt_buffer_add()    | Add a string of known length to a Buffer
  * | mutt_buffer_addch()  | Add a single character to a Buffer
  * | mutt_buffer_addstr() | Add a string to a Buffer
  * | mutt_buffer_free()   | Release a Buffer and its contents
@@ -118,7 +119,7 @@ struct Buffer *mutt_buffer_from(char *seed)
  * Always one byte bigger than necessary for the null terminator, and the
  * buffer is always NUL-terminated
  */
-static void mutt_buffer_add(struct Buffer *buf, const char *s, size_t len)
+void mutt_buffer_add(struct Buffer *buf, const char *s, size_t len)
 {
   if (!buf || !s)
     return;
@@ -45,6 +45,7 @@ void mutt_buffer_reset(struct Buffer *b);
 struct Buffer *mutt_buffer_from(char *seed);
 void mutt_buffer_free(struct Buffer **p);
 int mutt_buffer_printf(struct Buffer *buf, const char *fmt, ...);
+void mutt_buffer_add(struct Buffer *buf, const char *s, size_t len);
 void mutt_buffer_addstr(struct Buffer *buf, const char *s);
 void mutt_buffer_addch(struct Buffer *buf, char c);
 
@@ -0,0 +1,107 @@
+/**
+ * @file
+ * Shared copies of frequently repeated strings
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page intern Shared copies of frequently repeated strings
+ *
+ * Some header fields, e.g. labels and tags, take the same few values in
+ * thousands of messages.  Interning them keeps a single, reference-counted
+ * copy of each value in a Hash table.
+ *
+ * Two interned strings are equal if, and only if, they are the same pointer.
+ *
+ * @note Interned strings are shared: they must never be modified, and must be
+ *       released with mutt_str_unintern(), not FREE().
+ *
+ * | Function            | Description
+ * | :------------------ | :-----------------------------------
+ * | mutt_str_intern()   | Get a shared copy of a string
+ * | mutt_str_unintern() | Release a shared copy of a string
+ */
+
+#include "config.h"
+#include <stddef.h>
+#include <string.h>
+#include "intern.h"
+#include "hash.h"
+#include "memory.h"
+
+#define INTERN_HASH_SIZE 1031
+
+/**
+ * struct InternString - A shared string and its reference count
+ */
+struct InternString
+{
+  unsigned int refs; /**< number of users of the string */
+  char str[];        /**< the string itself, also the key in the Hash table */
+};
+
+static struct Hash *InternTable = NULL;
+
+/**
+ * mutt_str_intern - Get a shared copy of a string
+ * @param s String to copy
+ * @retval ptr  Shared copy of the string
+ * @retval NULL if s is NULL
+ *
+ * The caller should call mutt_str_unintern() to release the copy
+ */
+char *mutt_str_intern(const char *s)
+{
+  if (!s)
+    return NULL;
+
+  if (!InternTable)
+    InternTable = hash_create(INTERN_HASH_SIZE, 0);
+
+  struct InternString *is = hash_find(InternTable, s);
+  if (!is)
+  {
+    size_t len = strlen(s) + 1;
+    is = safe_malloc(sizeof(struct InternString) + len);
+    is->refs = 0;
+    memcpy(is->str, s, len);
+    hash_insert(InternTable, is->str, is);
+  }
+
+  is->refs++;
+  return is->str;
+}
+
+/**
+ * mutt_str_unintern - Release a shared copy of a string
+ * @param s Shared copy from mutt_str_intern()
+ *
+ * The string is freed once its last user has released it.
+ */
+void mutt_str_unintern(char **s)
+{
+  if (!s || !*s)
+    return;
+
+  struct InternString *is =
+      (struct InternString *) (*s - offsetof(struct InternString, str));
+  if (--is->refs == 0)
+  {
+    hash_delete(InternTable, is->str, is, NULL);
+    FREE(&is);
+  }
+  *s = NULL;
+}
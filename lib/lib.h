@@ -35,10 +35,12 @@
  * -# @subpage exit
  * -# @subpage file
  * -# @subpage hash
+ * -# @subpage intern
  * -# @subpage mapping
  * -# @subpage md5
  * -# @subpage memory
  * -# @subpage message
+ * -# @subpage pool
  * -# @subpage sha1
  * -# @subpage string
  */
@@ -53,11 +55,13 @@
 #include "exit.h"
 #include "file.h"
 #include "hash.h"
+#include "intern.h"
 #include "mapping.h"
 #include "md5.h"
 #include "memory.h"
 #include "memory.h"
 #include "message.h"
+#include "pool.h"
 #include "sha1.h"
 #include "string2.h"
 
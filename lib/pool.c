@@ -0,0 +1,182 @@
+/**
+ * @file
+ * Pools of fixed-size objects
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page pool Pools of fixed-size objects
+ *
+ * A mailbox holds one Header, Envelope and Body, and several Addresses, for
+ * every message.  Rather than asking malloc() for each of them, a pool carves
+ * the objects out of large blocks and keeps released objects on a free list
+ * for reuse.
+ *
+ * Once every object of a pool has been released, e.g. when a mailbox has been
+ * closed, mutt_pool_trim() returns its blocks to the system in one go.
+ *
+ * @note Objects from a pool must only be released with mutt_pool_free().
+ *
+ * | Function          | Description
+ * | :---------------- | :-----------------------------------------
+ * | mutt_pool_alloc() | Allocate a zeroed object from a pool
+ * | mutt_pool_free()  | Release an object back to its pool
+ * | mutt_pool_trim()  | Release the memory of all unused pools
+ */
+
+#include "config.h"
+#include <string.h>
+#include "pool.h"
+#include "memory.h"
+
+#define POOL_BLOCK_SIZE 16384
+
+/**
+ * union PoolAlign - Alignment suitable for any object
+ */
+union PoolAlign {
+  void *p;
+  long l;
+  long long ll;
+  double d;
+  long double ld;
+};
+
+#define POOL_ALIGN(x) (((x) + sizeof(union PoolAlign) - 1) & ~(sizeof(union PoolAlign) - 1))
+
+/**
+ * struct PoolBlock - A block of memory, followed by its objects
+ */
+struct PoolBlock
+{
+  struct PoolBlock *next;
+};
+
+/**
+ * struct PoolItem - An unused object, linked into the free list
+ */
+struct PoolItem
+{
+  struct PoolItem *next;
+};
+
+/**
+ * Pools - Pools that currently own some blocks
+ */
+static struct Pool *Pools = NULL;
+
+/**
+ * pool_grow - Add a new block of objects to a pool
+ * @param pool Pool to grow
+ */
+static void pool_grow(struct Pool *pool)
+{
+  size_t size = POOL_ALIGN(MAX(pool->size, sizeof(struct PoolItem)));
+  size_t offset = POOL_ALIGN(sizeof(struct PoolBlock));
+  size_t count = MAX(1, (POOL_BLOCK_SIZE - offset) / size);
+
+  struct PoolBlock *block = safe_malloc(offset + count * size);
+  char *base = (char *) block + offset;
+
+  if (!pool->blocks)
+  {
+    pool->next = Pools;
+    Pools = pool;
+  }
+  block->next = pool->blocks;
+  pool->blocks = block;
+
+  /* Link the objects in reverse, so they're handed out in address order */
+  for (size_t i = count; i > 0; i--)
+  {
+    struct PoolItem *item = (struct PoolItem *) (base + (i - 1) * size);
+    item->next = pool->free;
+    pool->free = item;
+  }
+}
+
+/**
+ * mutt_pool_alloc - Allocate a zeroed object from a pool
+ * @param pool Pool to use
+ * @retval ptr New object
+ *
+ * @note This function will never return NULL.
+ *       It will print and error and exit the program.
+ *
+ * The caller should call mutt_pool_free() to release the object
+ */
+void *mutt_pool_alloc(struct Pool *pool)
+{
+  if (!pool->free)
+    pool_grow(pool);
+
+  struct PoolItem *item = pool->free;
+  pool->free = item->next;
+  pool->used++;
+
+  memset(item, 0, pool->size);
+  return item;
+}
+
+/**
+ * mutt_pool_free - Release an object back to its pool
+ * @param pool Pool the object was allocated from
+ * @param pptr Pointer to the object to release (set to NULL)
+ */
+void mutt_pool_free(struct Pool *pool, void *pptr)
+{
+  if (!pptr)
+    return;
+  struct PoolItem **p = (struct PoolItem **) pptr;
+  if (*p)
+  {
+    (*p)->next = pool->free;
+    pool->free = *p;
+    pool->used--;
+    *p = NULL;
+  }
+}
+
+/**
+ * mutt_pool_trim - Release the memory of all unused pools
+ *
+ * The blocks of a pool are freed when none of its objects is in use.
+ * Pools that are still in use are left alone.
+ */
+void mutt_pool_trim(void)
+{
+  struct Pool **pp = &Pools;
+
+  while (*pp)
+  {
+    struct Pool *pool = *pp;
+    if (pool->used != 0)
+    {
+      pp = &pool->next;
+      continue;
+    }
+
+    while (pool->blocks)
+    {
+      struct PoolBlock *block = pool->blocks;
+      pool->blocks = block->next;
+      FREE(&block);
+    }
+    pool->free = NULL;
+    *pp = pool->next;
+    pool->next = NULL;
+  }
+}
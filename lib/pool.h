@@ -0,0 +1,46 @@
+/**
+ * @file
+ * Pools of fixed-size objects
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _LIB_POOL_H
+#define _LIB_POOL_H
+
+#include <stddef.h>
+
+struct PoolBlock;
+struct PoolItem;
+
+/**
+ * struct Pool - A pool of objects of one size
+ */
+struct Pool
+{
+  size_t size;              /**< size of an object */
+  size_t used;              /**< number of objects handed out */
+  struct PoolBlock *blocks; /**< blocks of memory holding the objects */
+  struct PoolItem *free;    /**< objects ready to be reused */
+  struct Pool *next;        /**< next pool that owns some blocks */
+};
+
+#define POOL_INITIALIZER(type) { sizeof(type), 0, NULL, NULL, NULL }
+
+void *mutt_pool_alloc(struct Pool *pool);
+void  mutt_pool_free(struct Pool *pool, void *pptr);
+void  mutt_pool_trim(void);
+
+#endif /* _LIB_POOL_H */
@@ -86,6 +86,13 @@ int mutt_filter_unprintable(char **s)
   char *p = *s;
   mbstate_t mbstate1, mbstate2;
 
+  /* Printable ASCII is always left alone */
+  while ((*p >= 0x20) && (*p < 0x7f))
+    p++;
+  if (!*p)
+    return 0;
+  p = *s;
+
   b = mutt_buffer_new();
   if (!b)
     return -1;
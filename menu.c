@@ -49,6 +49,22 @@
 
 char *SearchBuffers[MENU_MAX];
 
+/**
+ * struct MenuRow - What was last drawn on a row of a menu
+ */
+struct MenuRow
+{
+  int entry;     /**< menu entry, -1 for a blank row */
+  int attr;      /**< colour of the entry */
+  bool current;  /**< row had the cursor */
+  char *text;    /**< padded text of the entry */
+};
+
+/* Bumped when the screen is cleared, which invalidates all the MenuRows */
+static unsigned int MenuScreenGen = 1;
+/* Menu that last drew its entries */
+static struct Menu *MenuLastPainted = NULL;
+
 /* These are used to track the active menus, for redraw operations. */
 static size_t MenuStackCount = 0;
 static size_t MenuStackLen = 0;
@@ -89,7 +105,7 @@ static int get_color(int index, unsigned char *s)
 
   STAILQ_FOREACH(np, color, entries)
   {
-    if (mutt_pattern_exec(np->color_pattern, MUTT_MATCH_FULL_ADDRESS, Context, hdr, NULL))
+    if (mutt_pattern_exec(np->color_pattern, MUTT_MATCH_FULL_ADDRESS, Context, hdr))
       return np->pair;
   }
 
@@ -304,6 +320,7 @@ void menu_redraw_full(struct Menu *menu)
   /* clear() doesn't optimize screen redraws */
   move(0, 0);
   clrtobot();
+  menu_screen_cleared();
 
   if (option(OPT_HELP))
   {
@@ -343,14 +360,76 @@ void menu_redraw_sidebar(struct Menu *menu)
 }
 #endif
 
+/**
+ * menu_screen_cleared - Note that the screen has been cleared
+ *
+ * The next call to menu_redraw_index() will repaint every row.
+ */
+void menu_screen_cleared(void)
+{
+  MenuScreenGen++;
+  if (MenuScreenGen == 0)
+    MenuScreenGen = 1;
+}
+
+/**
+ * menu_rows_free - Forget what was drawn on the rows of a menu
+ * @param menu Menu
+ */
+static void menu_rows_free(struct Menu *menu)
+{
+  for (int i = 0; i < menu->rows_len; i++)
+    FREE(&menu->rows[i].text);
+  FREE(&menu->rows);
+  menu->rows_len = 0;
+  menu->rows_gen = 0;
+}
+
+/**
+ * menu_row_forget - Forget what was drawn on one row of a menu
+ * @param menu  Menu
+ * @param entry Entry drawn on the row
+ *
+ * This is used when a row is drawn without menu_redraw_index().
+ */
+static void menu_row_forget(struct Menu *menu, int entry)
+{
+  int row = entry - menu->top;
+  if ((row >= 0) && (row < menu->rows_len))
+    menu->rows[row].entry = -2;
+}
+
 void menu_redraw_index(struct Menu *menu)
 {
   char buf[LONG_STRING];
   bool do_color;
   int attr;
 
+  /* Rows that show the same thing as last time don't need repainting,
+   * unless something else has drawn over them */
+  if ((menu->rows_gen != MenuScreenGen) || (MenuLastPainted != menu) ||
+      (menu->rows_len != menu->pagelen))
+  {
+    menu_rows_free(menu);
+    menu->rows_len = menu->pagelen;
+    menu->rows = safe_calloc(menu->rows_len ? menu->rows_len : 1, sizeof(struct MenuRow));
+    for (int i = 0; i < menu->rows_len; i++)
+      menu->rows[i].entry = -2;
+  }
+  menu->rows_gen = MenuScreenGen;
+  MenuLastPainted = menu;
+
+  /* The index sub-colours are matched while printing, so they're not part of
+   * a row's text.  If any are in use, a row can't be trusted to be unchanged. */
+  bool may_skip = STAILQ_EMPTY(&ColorIndexAuthorList) &&
+                  STAILQ_EMPTY(&ColorIndexFlagsList) &&
+                  STAILQ_EMPTY(&ColorIndexSubjectList) &&
+                  STAILQ_EMPTY(&ColorIndexTagList);
+
   for (int i = menu->top; i < menu->top + menu->pagelen; i++)
   {
+    struct MenuRow *row = &menu->rows[i - menu->top];
+
     if (i < menu->max)
     {
       attr = menu->color(i);
@@ -358,6 +437,17 @@ void menu_redraw_index(struct Menu *menu)
       menu_make_entry(buf, sizeof(buf), menu, i);
       menu_pad_string(menu, buf, sizeof(buf));
 
+      bool current = (i == menu->current);
+      if (may_skip && (row->entry == i) && (row->attr == attr) &&
+          (row->current == current) && (mutt_strcmp(row->text, buf) == 0))
+      {
+        continue;
+      }
+      row->entry = i;
+      row->attr = attr;
+      row->current = current;
+      mutt_str_replace(&row->text, buf);
+
       ATTRSET(attr);
       mutt_window_move(menu->indexwin, i - menu->top + menu->offset, 0);
       do_color = true;
@@ -381,6 +471,10 @@ void menu_redraw_index(struct Menu *menu)
     }
     else
     {
+      if (row->entry == -1)
+        continue;
+      row->entry = -1;
+
       NORMAL_COLOR;
       mutt_window_clearline(menu->indexwin, i - menu->top + menu->offset);
     }
@@ -405,6 +499,8 @@ void menu_redraw_motion(struct Menu *menu)
    * generate status messages.  So we want to call it *before* we
    * position the cursor for drawing. */
   old_color = menu->color(menu->oldcurrent);
+  menu_row_forget(menu, menu->oldcurrent);
+  menu_row_forget(menu, menu->current);
   mutt_window_move(menu->indexwin, menu->oldcurrent + menu->offset - menu->top, 0);
   ATTRSET(old_color);
 
@@ -449,6 +545,7 @@ void menu_redraw_current(struct Menu *menu)
   char buf[LONG_STRING];
   int attr = menu->color(menu->current);
 
+  menu_row_forget(menu, menu->current);
   mutt_window_move(menu->indexwin, menu->current + menu->offset - menu->top, 0);
   menu_make_entry(buf, sizeof(buf), menu, menu->current);
   menu_pad_string(menu, buf, sizeof(buf));
@@ -831,6 +928,9 @@ void mutt_menu_destroy(struct Menu **p)
     FREE(&(*p)->dialog);
   }
 
+  menu_rows_free(*p);
+  if (MenuLastPainted == *p)
+    MenuLastPainted = NULL;
   FREE(p);
 }
 
@@ -948,7 +948,14 @@ static int maildir_move_to_context(struct Context *ctx, struct Maildir **md)
 }
 
 #ifdef USE_HCACHE
-static size_t maildir_hcache_keylen(const char *fn)
+/**
+ * maildir_hcache_keylen - Calculate the length of the Maildir path
+ * @param fn File name
+ * @retval size_t Length of the path, excluding the flags
+ *
+ * @note This length excludes the flags, which will vary
+ */
+size_t maildir_hcache_keylen(const char *fn)
 {
   const char *p = strrchr(fn, ':');
   return p ? (size_t)(p - fn) : mutt_strlen(fn);
@@ -312,8 +312,9 @@ int mutt_remove_from_regex_list(struct RegexList **l, const char *str);
 
 void mutt_init(int skip_sys_rc, struct ListHead *commands);
 
-/* flag to mutt_pattern_comp() */
-#define MUTT_FULL_MSG (1 << 0) /* enable body and header matching */
+/* flags to mutt_pattern_comp() */
+#define MUTT_FULL_MSG     (1 << 0) /* enable body and header matching */
+#define MUTT_PATTERN_MEMO (1 << 1) /* memoize results in the Header */
 
 /**
  * struct AttachMatch - An attachment matching a regex
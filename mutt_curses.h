@@ -193,6 +193,9 @@ struct ColorLine
   regex_t regex;
   int match; /**< which substringmap 0 for old behaviour */
   char *pattern;
+  char *literal;        /**< text every match contains, see mutt_regex_literal() */
+  bool icase : 1;       /**< regex is case-insensitive */
+  bool word_bounds : 1; /**< regex contains a word boundary, e.g. "\\<" */
   struct Pattern *color_pattern; /**< compiled pattern to speed up index color
                                       calculation */
   short fg;
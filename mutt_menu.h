@@ -97,6 +97,11 @@ struct Menu
   int oldcurrent; /**< for driver use only. */
   int search_dir;  /**< direction of search */
   int tagged;     /**< number of tagged entries */
+
+  /* used by menu_redraw_index() to only repaint rows that have changed */
+  struct MenuRow *rows;  /**< what was last drawn on each row */
+  int rows_len;          /**< number of entries in rows */
+  unsigned int rows_gen; /**< MenuScreenGen when rows were drawn */
 };
 
 void mutt_menu_init(void);
@@ -108,6 +113,7 @@ void menu_redraw_index(struct Menu *menu);
 void menu_redraw_status(struct Menu *menu);
 void menu_redraw_motion(struct Menu *menu);
 void menu_redraw_current(struct Menu *menu);
+void menu_screen_cleared(void);
 int menu_redraw(struct Menu *menu);
 void menu_first_entry(struct Menu *menu);
 void menu_last_entry(struct Menu *menu);
@@ -47,7 +47,9 @@ struct Regex
 {
   char *pattern;  /**< printable version */
   regex_t *regex; /**< compiled expression */
+  char *literal;  /**< string that every match contains, see mutt_regex_literal() */
   bool not : 1;   /**< do not match */
+  bool icase : 1; /**< the regex ignores case */
 };
 
 /**
@@ -76,4 +78,6 @@ WHERE struct Regex ReplyRegexp;
 WHERE struct Regex Smileys;
 WHERE struct Regex GecosMask;
 
+int mutt_regexec(const struct Regex *rx, const char *s, size_t nmatch, regmatch_t pmatch[]);
+
 #endif /* _MUTT_REGEX_H */
@@ -24,6 +24,7 @@
 
 #include "config.h"
 #include "lib/hash.h"
+#include "lib/intern.h"
 #include "lib/string2.h"
 #include "globals.h"
 #include "mutt_tags.h"
@@ -44,8 +45,8 @@ void driver_tags_free(struct TagHead *head)
   while (np)
   {
     next = STAILQ_NEXT(np, entries);
-    FREE(&np->name);
-    FREE(&np->transformed);
+    mutt_str_unintern(&np->name);
+    mutt_str_unintern(&np->transformed);
     FREE(&np);
     np = next;
   }
@@ -143,10 +144,10 @@ static void driver_tags_add(struct TagHead *head, char *new_tag)
   char *new_tag_transformed = hash_find(TagTransforms, new_tag);
 
   struct TagNode *np = safe_calloc(1, sizeof(struct TagNode));
-  np->name = safe_strdup(new_tag);
+  np->name = mutt_str_intern(new_tag);
   np->hidden = false;
   if (new_tag_transformed)
-    np->transformed = safe_strdup(new_tag_transformed);
+    np->transformed = mutt_str_intern(new_tag_transformed);
 
   /* filter out hidden tags */
   if (HiddenTags)
@@ -156,6 +156,18 @@ int mutt_remove_from_regex_list(struct RegexList **l, const char *str)
   return rv;
 }
 
+static struct Pool HeaderPool = POOL_INITIALIZER(struct Header);
+
+struct Header *mutt_new_header(void)
+{
+  struct Header *h = mutt_pool_alloc(&HeaderPool);
+#ifdef MIXMASTER
+  STAILQ_INIT(&h->chain);
+#endif
+  STAILQ_INIT(&h->tags);
+  return h;
+}
+
 void mutt_free_header(struct Header **h)
 {
   if (!h || !*h)
@@ -163,6 +175,7 @@ void mutt_free_header(struct Header **h)
   mutt_free_envelope(&(*h)->env);
   mutt_free_body(&(*h)->content);
   FREE(&(*h)->maildir_flags);
+  FREE(&(*h)->memo);
   FREE(&(*h)->tree);
   FREE(&(*h)->path);
 #ifdef MIXMASTER
@@ -174,7 +187,7 @@ void mutt_free_header(struct Header **h)
     (*h)->free_cb(*h);
   FREE(&(*h)->data);
 #endif
-  FREE(h);
+  mutt_pool_free(&HeaderPool, h);
 }
 
 /**
@@ -857,7 +870,7 @@ char *mutt_apply_replace(char *dbuf, size_t dlen, char *sbuf, struct ReplaceList
       nmatch = l->nmatch;
     }
 
-    if (regexec(l->regex->regex, src, l->nmatch, pmatch, 0) == 0)
+    if (mutt_regexec(l->regex, src, l->nmatch, pmatch) == 0)
     {
       tlen = 0;
       switcher ^= 1;
@@ -1582,20 +1595,459 @@ const char *mutt_make_version(void)
   return vstring;
 }
 
+#define REGEX_SET_MIN 8        /**< Shorter lists are matched rule by rule */
+#define REGEX_SET_BUCKETS 1024 /**< Number of literal prefix buckets */
+#define REGEX_SET_CACHE 16     /**< Number of lists to keep a RegexSet for */
+
+/**
+ * struct RegexSet - All the rules of a regex list, for matching in one pass
+ *
+ * The required literals of the rules (see mutt_regex_literal()) are indexed
+ * by their first two characters.  A single pass over the input finds every
+ * rule whose literal occurs in it; only those rules, and the rules without a
+ * literal, need to be run through the regex engine.
+ */
+struct RegexSet
+{
+  const void *head;         /**< First node of the list */
+  unsigned int generation;  /**< Value of RegexGeneration when built */
+  int count;                /**< Number of rules */
+  const struct Regex **rx;  /**< Regex of each rule, in list order */
+  size_t *litlen;           /**< Length of each rule's literal */
+  int *bucket_start;        /**< Start of each bucket in bucket_rules */
+  int *bucket_rules;        /**< Rule numbers, grouped by bucket */
+  unsigned char *always;    /**< Rules without a literal */
+  unsigned char *candidate; /**< Rules that may match the current string */
+};
+
+/* Changed whenever a Regex is created or freed, which invalidates the
+ * RegexSets of all lists */
+static unsigned int RegexGeneration = 0;
+static struct RegexSet *RegexSets[REGEX_SET_CACHE];
+static int RegexSetNext = 0;
+
+static inline unsigned int regex_set_bucket(unsigned char a, unsigned char b)
+{
+  return ((tolower(a) << 5) ^ tolower(b)) & (REGEX_SET_BUCKETS - 1);
+}
+
+static void regex_set_free(struct RegexSet **set)
+{
+  if (!set || !*set)
+    return;
+
+  FREE(&(*set)->rx);
+  FREE(&(*set)->litlen);
+  FREE(&(*set)->bucket_start);
+  FREE(&(*set)->bucket_rules);
+  FREE(&(*set)->always);
+  FREE(&(*set)->candidate);
+  FREE(set);
+}
+
+/**
+ * regex_set_new - Index the literals of a list of rules
+ * @param head  First node of the list
+ * @param rx    Regex of each rule, in list order
+ * @param count Number of rules
+ * @retval ptr New RegexSet
+ */
+static struct RegexSet *regex_set_new(const void *head, const struct Regex **rx, int count)
+{
+  struct RegexSet *set = safe_calloc(1, sizeof(struct RegexSet));
+  int nlit = 0;
+
+  set->head = head;
+  set->generation = RegexGeneration;
+  set->count = count;
+  set->rx = rx;
+  set->litlen = safe_calloc(count, sizeof(size_t));
+  set->bucket_start = safe_calloc(REGEX_SET_BUCKETS + 1, sizeof(int));
+  set->always = safe_calloc(count, 1);
+  set->candidate = safe_calloc(count, 1);
+
+  /* Count the rules in each bucket, then lay the buckets out end to end */
+  for (int i = 0; i < count; i++)
+  {
+    const unsigned char *lit = (const unsigned char *) rx[i]->literal;
+    if (lit)
+    {
+      set->litlen[i] = strlen(rx[i]->literal);
+      set->bucket_start[regex_set_bucket(lit[0], lit[1]) + 1]++;
+      nlit++;
+    }
+    else
+      set->always[i] = 1;
+  }
+
+  for (int b = 0; b < REGEX_SET_BUCKETS; b++)
+    set->bucket_start[b + 1] += set->bucket_start[b];
+
+  int *fill = safe_calloc(REGEX_SET_BUCKETS, sizeof(int));
+  set->bucket_rules = safe_calloc(nlit ? nlit : 1, sizeof(int));
+  for (int i = 0; i < count; i++)
+  {
+    const unsigned char *lit = (const unsigned char *) rx[i]->literal;
+    if (!lit)
+      continue;
+    unsigned int b = regex_set_bucket(lit[0], lit[1]);
+    set->bucket_rules[set->bucket_start[b] + fill[b]++] = i;
+  }
+  FREE(&fill);
+
+  return set;
+}
+
+/**
+ * regex_set_lookup - Find the cached RegexSet of a list
+ * @param head First node of the list
+ * @retval ptr  RegexSet, if it's still valid
+ * @retval NULL Otherwise
+ */
+static struct RegexSet *regex_set_lookup(const void *head)
+{
+  for (int i = 0; i < REGEX_SET_CACHE; i++)
+  {
+    struct RegexSet *set = RegexSets[i];
+    if (set && (set->head == head))
+    {
+      if (set->generation == RegexGeneration)
+        return set;
+      regex_set_free(&RegexSets[i]);
+      return NULL;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * regex_set_store - Cache the RegexSet of a list
+ * @param set RegexSet to cache
+ */
+static void regex_set_store(struct RegexSet *set)
+{
+  regex_set_free(&RegexSets[RegexSetNext]);
+  RegexSets[RegexSetNext] = set;
+  RegexSetNext = (RegexSetNext + 1) % REGEX_SET_CACHE;
+}
+
+/**
+ * regex_set_scan - Find the rules that may match a string
+ * @param set RegexSet
+ * @param s   String to match
+ *
+ * After the scan, set->candidate is non-zero for each rule that needs to be
+ * run through the regex engine.
+ */
+static void regex_set_scan(struct RegexSet *set, const char *s)
+{
+  memcpy(set->candidate, set->always, set->count);
+
+  for (const unsigned char *p = (const unsigned char *) s; p[0] && p[1]; p++)
+  {
+    unsigned int b = regex_set_bucket(p[0], p[1]);
+    for (int j = set->bucket_start[b]; j < set->bucket_start[b + 1]; j++)
+    {
+      int i = set->bucket_rules[j];
+      if (set->candidate[i])
+        continue;
+
+      const struct Regex *rx = set->rx[i];
+      if (rx->icase ? (strncasecmp((const char *) p, rx->literal, set->litlen[i]) == 0) :
+                      (strncmp((const char *) p, rx->literal, set->litlen[i]) == 0))
+        set->candidate[i] = 1;
+    }
+  }
+}
+
+/**
+ * regex_list_set - Get a RegexSet for a RegexList
+ * @param l RegexList
+ * @retval ptr  RegexSet
+ * @retval NULL If the list is too short to benefit from one
+ */
+static struct RegexSet *regex_list_set(struct RegexList *l)
+{
+  struct RegexSet *set = regex_set_lookup(l);
+  if (set)
+    return set;
+
+  int count = 0;
+  for (struct RegexList *np = l; np; np = np->next)
+    count++;
+  if (count < REGEX_SET_MIN)
+    return NULL;
+
+  const struct Regex **rx = safe_calloc(count, sizeof(struct Regex *));
+  count = 0;
+  for (struct RegexList *np = l; np; np = np->next)
+    rx[count++] = np->regex;
+
+  set = regex_set_new(l, rx, count);
+  regex_set_store(set);
+  return set;
+}
+
+/**
+ * replace_list_set - Get a RegexSet for a ReplaceList
+ * @param l ReplaceList
+ * @retval ptr  RegexSet
+ * @retval NULL If the list is too short to benefit from one
+ */
+static struct RegexSet *replace_list_set(struct ReplaceList *l)
+{
+  struct RegexSet *set = regex_set_lookup(l);
+  if (set)
+    return set;
+
+  int count = 0;
+  for (struct ReplaceList *np = l; np; np = np->next)
+    count++;
+  if (count < REGEX_SET_MIN)
+    return NULL;
+
+  const struct Regex **rx = safe_calloc(count, sizeof(struct Regex *));
+  count = 0;
+  for (struct ReplaceList *np = l; np; np = np->next)
+    rx[count++] = np->regex;
+
+  set = regex_set_new(l, rx, count);
+  regex_set_store(set);
+  return set;
+}
+
+/**
+ * regex_skip_quantifier - Skip over a quantifier in a regex
+ * @param s Position after an atom
+ * @retval ptr First character after the quantifier (if any)
+ */
+static const char *regex_skip_quantifier(const char *s)
+{
+  while (*s)
+  {
+    if ((*s == '*') || (*s == '+') || (*s == '?'))
+      s++;
+    else if (*s == '{')
+    {
+      const char *end = strchr(s, '}');
+      if (!end)
+        break;
+      s = end + 1;
+    }
+    else
+      break;
+  }
+  return s;
+}
+
+/**
+ * regex_skip_bracket - Skip over a bracket expression, e.g. [^a-z]
+ * @param s Position of the opening '['
+ * @retval ptr First character after the closing ']'
+ */
+static const char *regex_skip_bracket(const char *s)
+{
+  s++;
+  if (*s == '^')
+    s++;
+  if (*s == ']')
+    s++;
+  for (; *s && (*s != ']'); s++)
+  {
+    /* [:class:], [.coll.] and [=equiv=] may contain a ']' */
+    if ((s[0] == '[') && ((s[1] == ':') || (s[1] == '.') || (s[1] == '=')))
+    {
+      const char *end = strchr(s + 2, s[1]);
+      while (end && (end[1] != ']'))
+        end = strchr(end + 1, s[1]);
+      if (!end)
+        return s + strlen(s);
+      s = end + 1;
+    }
+  }
+  return *s ? s + 1 : s;
+}
+
+/**
+ * regex_skip_group - Skip over a parenthesised sub-expression
+ * @param s Position of the opening '('
+ * @retval ptr First character after the closing ')'
+ */
+static const char *regex_skip_group(const char *s)
+{
+  int depth = 0;
+
+  while (*s)
+  {
+    if (*s == '\\')
+    {
+      s++;
+      if (*s)
+        s++;
+      continue;
+    }
+    if (*s == '[')
+    {
+      s = regex_skip_bracket(s);
+      continue;
+    }
+    if (*s == '(')
+      depth++;
+    else if ((*s == ')') && (--depth == 0))
+      return s + 1;
+    s++;
+  }
+  return s;
+}
+
+/**
+ * mutt_regex_literal - Find a string that every match of a regex contains
+ * @param s    Extended regular expression, as compiled by REGCOMP()
+ * @retval ptr Longest literal run that any match must contain
+ * @retval NULL If there isn't a useful one, e.g. "foo|bar"
+ *
+ * The literal is used to reject most non-matching strings with a fast
+ * substring search before running the regex engine.  The analysis is
+ * conservative: anything it doesn't understand ends the current run.
+ * Non-ASCII bytes always end a run, because a quantifier after a multibyte
+ * character applies to the whole character, and because case-insensitive
+ * matching of non-ASCII characters isn't byte-wise.
+ *
+ * The literal doesn't depend on the case of the match.  If the regex ignores
+ * case, the caller must search for the literal ignoring case, too.
+ *
+ * The caller must free the returned string.
+ */
+char *mutt_regex_literal(const char *s)
+{
+  char cur[STRING];
+  char best[STRING];
+  size_t curlen = 0;
+  size_t bestlen = 0;
+
+  if (!s)
+    return NULL;
+
+  while (*s)
+  {
+    char c = 0;
+
+    switch (*s)
+    {
+      case '|':
+        return NULL; /* alternation: no single required literal */
+      case '(':
+        s = regex_skip_quantifier(regex_skip_group(s));
+        break;
+      case '[':
+        s = regex_skip_quantifier(regex_skip_bracket(s));
+        break;
+      case '.':
+      case '^':
+      case '$':
+      case '*':
+      case '+':
+      case '?':
+      case '{':
+        s = regex_skip_quantifier(s + 1);
+        break;
+      case '\\':
+        /* \w, \<, \1, etc. aren't literals, but \. \* \\ are */
+        if (s[1] && (isalnum((unsigned char) s[1]) || (s[1] == '<') ||
+                     (s[1] == '>') || (s[1] == '`') || (s[1] == '\'')))
+          s = regex_skip_quantifier(s + 2);
+        else if (s[1])
+        {
+          c = s[1];
+          s += 2;
+        }
+        else
+          s++;
+        break;
+      default:
+        c = *s++;
+        break;
+    }
+
+    if (c && !(c & 0x80) && (curlen < (sizeof(cur) - 1)))
+    {
+      const char *end = regex_skip_quantifier(s);
+      if (end == s)
+      {
+        cur[curlen++] = c;
+        continue;
+      }
+
+      /* The character is only required if every quantifier is '+', but
+       * even then, it may repeat, so the run ends here */
+      if (strspn(s, "+") == (size_t)(end - s))
+        cur[curlen++] = c;
+      s = end;
+    }
+
+    /* anything else ends the current run */
+    if (curlen > bestlen)
+    {
+      memcpy(best, cur, curlen);
+      bestlen = curlen;
+    }
+    curlen = 0;
+  }
+
+  if (curlen > bestlen)
+  {
+    memcpy(best, cur, curlen);
+    bestlen = curlen;
+  }
+
+  if (bestlen < 2)
+    return NULL;
+
+  return mutt_substrdup(best, best + bestlen);
+}
+
 struct Regex *mutt_compile_regex(const char *s, int flags)
 {
   struct Regex *pp = safe_calloc(1, sizeof(struct Regex));
   pp->pattern = safe_strdup(s);
   pp->regex = safe_calloc(1, sizeof(regex_t));
   if (REGCOMP(pp->regex, NONULL(s), flags) != 0)
+  {
     mutt_free_regex(&pp);
+    return NULL;
+  }
 
+  pp->literal = mutt_regex_literal(s);
+  pp->icase = (flags & REG_ICASE);
+  RegexGeneration++;
   return pp;
 }
 
+/**
+ * mutt_regexec - Match a string against a Regex
+ * @param rx     Compiled Regex
+ * @param s      String to match
+ * @param nmatch Size of pmatch
+ * @param pmatch Array for the sub-match positions (may be NULL)
+ * @retval 0           Match
+ * @retval REG_NOMATCH No match
+ *
+ * If the regex contains a required literal, strings without it are rejected
+ * with a substring search, without running the regex engine.
+ */
+int mutt_regexec(const struct Regex *rx, const char *s, size_t nmatch, regmatch_t pmatch[])
+{
+  if (rx->literal && !(rx->icase ? strcasestr(s, rx->literal) : strstr(s, rx->literal)))
+    return REG_NOMATCH;
+
+  return regexec(rx->regex, s, nmatch, pmatch, 0);
+}
+
 void mutt_free_regex(struct Regex **pp)
 {
+  RegexGeneration++;
   FREE(&(*pp)->pattern);
+  FREE(&(*pp)->literal);
   regfree((*pp)->regex);
   FREE(&(*pp)->regex);
   FREE(pp);
@@ -1637,9 +2089,14 @@ bool mutt_match_regex_list(const char *s, struct RegexList *l)
   if (!s)
     return false;
 
-  for (; l; l = l->next)
+  struct RegexSet *set = regex_list_set(l);
+  if (set)
+    regex_set_scan(set, s);
+
+  for (int i = 0; l; l = l->next, i++)
   {
-    if (regexec(l->regex->regex, s, (size_t) 0, (regmatch_t *) 0, (int) 0) == 0)
+    if (set ? (set->candidate[i] && (regexec(l->regex->regex, s, 0, NULL, 0) == 0)) :
+              (mutt_regexec(l->regex, s, 0, NULL) == 0))
     {
       mutt_debug(5, "mutt_match_regex_list: %s matches %s\n", s, l->regex->pattern);
       return true;
@@ -1673,8 +2130,15 @@ bool mutt_match_spam_list(const char *s, struct ReplaceList *l, char *text, int
   if (!s)
     return false;
 
-  for (; l; l = l->next)
+  struct RegexSet *set = replace_list_set(l);
+  if (set)
+    regex_set_scan(set, s);
+
+  for (int i = 0; l; l = l->next, i++)
   {
+    if (set && !set->candidate[i])
+      continue;
+
     /* If this pattern needs more matches, expand pmatch. */
     if (l->nmatch > nmatch)
     {
@@ -1683,7 +2147,8 @@ bool mutt_match_spam_list(const char *s, struct ReplaceList *l, char *text, int
     }
 
     /* Does this pattern match? */
-    if (regexec(l->regex->regex, s, (size_t) l->nmatch, (regmatch_t *) pmatch, (int) 0) == 0)
+    if ((set ? regexec(l->regex->regex, s, (size_t) l->nmatch, pmatch, 0) :
+               mutt_regexec(l->regex, s, (size_t) l->nmatch, pmatch)) == 0)
     {
       mutt_debug(5, "mutt_match_spam_list: %s matches %s\n", s, l->regex->pattern);
       mutt_debug(5, "mutt_match_spam_list: %d subs\n", (int) l->regex->regex->re_nsub);
@@ -544,12 +544,15 @@ void mx_fastclose_mailbox(struct Context *ctx)
   for (int i = 0; i < ctx->msgcount; i++)
     mutt_free_header(&ctx->hdrs[i]);
   FREE(&ctx->hdrs);
+  /* Return the messages' memory in bulk, unless another mailbox still uses it */
+  mutt_pool_trim();
   FREE(&ctx->v2r);
   FREE(&ctx->path);
   FREE(&ctx->realpath);
   FREE(&ctx->pattern);
   if (ctx->limit_pattern)
     mutt_pattern_free(&ctx->limit_pattern);
+  mutt_range_index_free(&ctx->range_index);
   safe_fclose(&ctx->fp);
   memset(ctx, 0, sizeof(struct Context));
 }
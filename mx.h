@@ -102,6 +102,7 @@ void maildir_flags(char *dest, size_t destlen, struct Header *hdr);
 
 #ifdef USE_HCACHE
 int mh_sync_mailbox_message(struct Context *ctx, int msgno, header_cache_t *hc);
+size_t maildir_hcache_keylen(const char *fn);
 #else
 int mh_sync_mailbox_message(struct Context *ctx, int msgno);
 #endif
@@ -43,6 +43,7 @@
 #include "mx.h"
 #include "ncrypt/ncrypt.h"
 #include "options.h"
+#include "pattern.h"
 #include "protos.h"
 #include "thread.h"
 #include "url.h"
@@ -1670,6 +1671,7 @@ static int nntp_open_message(struct Context *ctx, struct Message *msg, int msgno
 
   mutt_free_envelope(&hdr->env);
   hdr->env = mutt_read_rfc822_header(msg->fp, hdr, 0, 0);
+  mutt_pattern_memo_invalidate(hdr);
 
   if (ctx->id_hash && hdr->env->message_id)
     hash_insert(ctx->id_hash, hdr->env->message_id, hdr);
@@ -41,6 +41,9 @@ enum GlobalBool
   OPT_AUTO_TAG,
   OPT_BEEP,
   OPT_BEEP_NEW,
+#ifdef USE_HCACHE
+  OPT_BODY_INDEX,
+#endif
   OPT_BOUNCE_DELIVERED,
   OPT_BRAILLE_FRIENDLY,
   OPT_CHECK_MBOX_SIZE,
@@ -128,6 +128,16 @@ struct QClass
   struct QClass *down, *up;
 };
 
+/**
+ * struct QuoteList - Quoting classes of a message
+ */
+struct QuoteList
+{
+  struct QClass *head;   /**< top level classes */
+  struct Hash *prefixes; /**< classes indexed by their prefix */
+  int level;             /**< number of classes, i.e. next colour index */
+};
+
 /**
  * struct Syntax - Highlighting for a line of text
  */
@@ -186,6 +196,20 @@ static struct Resize
 } *Resize = NULL;
 #endif
 
+/**
+ * struct LineBuffer - Buffers used by display_line()
+ *
+ * Laying out a large message calls display_line() once per line, so the
+ * buffers are kept between calls, rather than being allocated and freed for
+ * every line.  They're released when the pager exits.
+ */
+static struct LineBuffer
+{
+  unsigned char *buf; /**< raw text of the line */
+  unsigned char *fmt; /**< line without attributes */
+  size_t len;         /**< size of the buffers */
+} LineBuffer;
+
 #define NUM_SIG_LINES 4
 
 static int check_sig(const char *s, struct Line *info, int n)
@@ -432,9 +456,44 @@ static void cleanup_quote(struct QClass **quote_list)
   return;
 }
 
-static struct QClass *classify_quote(struct QClass **quote_list, const char *qptr,
-                                     int length, int *force_redraw, int *q_level)
+/**
+ * new_quote_class - Create a quoting class
+ * @param qlist  Quoting classes of the message
+ * @param qptr   Quote prefix
+ * @param length Length of the prefix
+ * @retval ptr New class, not yet linked into the tree
+ */
+static struct QClass *new_quote_class(struct QuoteList *qlist, const char *qptr, int length)
+{
+  struct QClass *class = safe_calloc(1, sizeof(struct QClass));
+  class->prefix = safe_calloc(1, length + 1);
+  strncpy(class->prefix, qptr, length);
+  class->length = length;
+
+  if (!qlist->prefixes)
+    qlist->prefixes = hash_create(128, 0);
+  hash_insert(qlist->prefixes, class->prefix, class);
+
+  return class;
+}
+
+/**
+ * classify_quote - Find the quoting class of a prefix
+ * @param qlist        Quoting classes of the message
+ * @param qptr         Quote prefix
+ * @param length       Length of the prefix
+ * @param force_redraw Set if the colours of existing classes changed
+ * @retval ptr Quoting class
+ *
+ * Most quoted lines repeat a prefix that has already been seen, so the
+ * classes are looked up by prefix first.  Only a new prefix needs to walk
+ * the tree to find its place.
+ */
+static struct QClass *classify_quote(struct QuoteList *qlist, const char *qptr,
+                                     int length, int *force_redraw)
 {
+  struct QClass **quote_list = &qlist->head;
+  int *q_level = &qlist->level;
   struct QClass *q_list = *quote_list;
   struct QClass *class = NULL, *tmp = NULL, *ptr = NULL, *save = NULL;
   char *tail_qptr = NULL;
@@ -454,6 +513,16 @@ static struct QClass *classify_quote(struct QClass **quote_list, const char *qpt
     return *quote_list;
   }
 
+  if (qlist->prefixes && (length < LONG_STRING))
+  {
+    char key[LONG_STRING];
+    memcpy(key, qptr, length);
+    key[length] = '\0';
+    class = hash_find(qlist->prefixes, key);
+    if (class)
+      return class;
+  }
+
   /* Did I mention how much I like emulating Lisp in C? */
 
   /* classify quoting prefix */
@@ -472,10 +541,7 @@ static struct QClass *classify_quote(struct QClass **quote_list, const char *qpt
         if (!tmp)
         {
           /* add a node above q_list */
-          tmp = safe_calloc(1, sizeof(struct QClass));
-          tmp->prefix = safe_calloc(1, length + 1);
-          strncpy(tmp->prefix, qptr, length);
-          tmp->length = length;
+          tmp = new_quote_class(qlist, qptr, length);
 
           /* replace q_list by tmp in the top level list */
           if (q_list->next)
@@ -582,10 +648,7 @@ static struct QClass *classify_quote(struct QClass **quote_list, const char *qpt
               if (!tmp)
               {
                 /* add a node above q_list */
-                tmp = safe_calloc(1, sizeof(struct QClass));
-                tmp->prefix = safe_calloc(1, length + 1);
-                strncpy(tmp->prefix, qptr, length);
-                tmp->length = length;
+                tmp = new_quote_class(qlist, qptr, length);
 
                 /* replace q_list by tmp */
                 if (q_list->next)
@@ -684,10 +747,7 @@ static struct QClass *classify_quote(struct QClass **quote_list, const char *qpt
         /* still not found so far: add it as a sibling to the current node */
         if (!class)
         {
-          tmp = safe_calloc(1, sizeof(struct QClass));
-          tmp->prefix = safe_calloc(1, length + 1);
-          strncpy(tmp->prefix, qptr, length);
-          tmp->length = length;
+          tmp = new_quote_class(qlist, qptr, length);
 
           if (ptr->down)
           {
@@ -721,10 +781,7 @@ static struct QClass *classify_quote(struct QClass **quote_list, const char *qpt
   if (!class)
   {
     /* not found so far: add it as a top level class */
-    class = safe_calloc(1, sizeof(struct QClass));
-    class->prefix = safe_calloc(1, length + 1);
-    strncpy(class->prefix, qptr, length);
-    class->length = length;
+    class = new_quote_class(qlist, qptr, length);
     new_class_color(class, q_level);
 
     if (*quote_list)
@@ -753,15 +810,158 @@ static int check_attachment_marker(char *p)
   return (int) (*p - *q);
 }
 
+/**
+ * struct ColorMatch - Next match of a colour regex in the current line
+ */
+struct ColorMatch
+{
+  regoff_t first; /**< start of the match, -1 if there is none */
+  regoff_t last;  /**< end of the match */
+  bool searched;  /**< first/last are valid for an earlier offset */
+  bool fixed;     /**< the result can't change, e.g. the literal is missing */
+};
+
+/**
+ * match_color_lines - Find the coloured chunks of a line
+ * @param buf        Line, without its newline
+ * @param line_info  Line info array
+ * @param n          Line number
+ * @param head       Colour regexes to apply
+ *
+ * Every regex is run once per line and its next match is remembered.  After
+ * a chunk has been coloured, only the regexes whose match overlapped it are
+ * run again, from the end of the chunk.  The result is the same as running
+ * every regex again from the end of each chunk: the leftmost match starting
+ * at or after the new offset was already found from the earlier offset.
+ * Regexes with word boundaries depend on where the search starts, so they are
+ * always re-run.  Regexes with a literal missing from the line are skipped.
+ *
+ * The chunks are collected in a scratch buffer and copied into the line once.
+ */
+static void match_color_lines(char *buf, struct Line *line_info, int n,
+                              struct ColorLineHead *head)
+{
+  static struct ColorMatch *matches = NULL;
+  static size_t matches_max = 0;
+  static struct Syntax *chunks = NULL;
+  static size_t chunks_max = 0;
+  struct ColorLine *color_line = NULL;
+  regmatch_t pmatch[1];
+  size_t count = 0;
+  int offset = 0;
+  int nchunks = 0;
+  bool found;
+  bool null_rx;
+
+  line_info[n].chunks = 0;
+
+  STAILQ_FOREACH(color_line, head, entries)
+  {
+    count++;
+  }
+  if (count == 0)
+    return;
+
+  if (count > matches_max)
+  {
+    matches_max = count;
+    safe_realloc(&matches, matches_max * sizeof(struct ColorMatch));
+  }
+
+  struct ColorMatch *m = matches;
+  STAILQ_FOREACH(color_line, head, entries)
+  {
+    m->first = -1;
+    m->last = -1;
+    m->searched = false;
+    m->fixed = color_line->literal &&
+               !(color_line->icase ? strcasestr(buf, color_line->literal) :
+                                     strstr(buf, color_line->literal));
+    m++;
+  }
+
+  do
+  {
+    if (!buf[offset])
+      break;
+
+    found = false;
+    null_rx = false;
+    m = matches;
+    STAILQ_FOREACH(color_line, head, entries)
+    {
+      if (!m->fixed && (!m->searched || color_line->word_bounds ||
+                        ((m->first >= 0) && ((m->first < offset) || (m->first == m->last)))))
+      {
+        if (regexec(&color_line->regex, buf + offset, 1, pmatch,
+                    (offset ? REG_NOTBOL : 0)) == 0)
+        {
+          m->first = pmatch[0].rm_so + offset;
+          m->last = pmatch[0].rm_eo + offset;
+        }
+        else
+          m->first = m->last = -1;
+        m->searched = true;
+      }
+
+      if (m->first >= 0)
+      {
+        if (m->last != m->first)
+        {
+          if (!found)
+          {
+            /* Abort if we fill up chunks.
+             * Yes, this really happened. See #3888 */
+            if (nchunks == SHRT_MAX)
+            {
+              null_rx = false;
+              break;
+            }
+            if (++nchunks > chunks_max)
+            {
+              chunks_max = MAX(nchunks, chunks_max * 2);
+              safe_realloc(&chunks, chunks_max * sizeof(struct Syntax));
+            }
+          }
+          struct Syntax *chunk = &chunks[nchunks - 1];
+          if (!found || (m->first < chunk->first) ||
+              ((m->first == chunk->first) && (m->last > chunk->last)))
+          {
+            chunk->color = color_line->pair;
+            chunk->first = m->first;
+            chunk->last = m->last;
+          }
+          found = true;
+          null_rx = false;
+        }
+        else
+          null_rx = true; /* empty regex; don't add it, but keep looking */
+      }
+      m++;
+    }
+
+    if (null_rx)
+      offset++; /* avoid degenerate cases */
+    else if (nchunks > 0)
+      offset = chunks[nchunks - 1].last;
+  } while (found || null_rx);
+
+  if (nchunks > 0)
+  {
+    if (nchunks > 1)
+      safe_realloc(&(line_info[n].syntax), nchunks * sizeof(struct Syntax));
+    memcpy(line_info[n].syntax, chunks, nchunks * sizeof(struct Syntax));
+  }
+  line_info[n].chunks = nchunks;
+}
+
 static void resolve_types(char *buf, char *raw, struct Line *line_info, int n,
-                          int last, struct QClass **quote_list, int *q_level,
+                          int last, struct QuoteList *quote_list,
                           int *force_redraw, int q_classify)
 {
   struct ColorLine *color_line = NULL;
   regmatch_t pmatch[1], smatch[1];
-  bool found;
-  bool null_rx;
-  int offset, i;
+  int i;
 
   if (n == 0 || ISHEADER(line_info[n - 1].type))
   {
@@ -864,7 +1064,7 @@ static void resolve_types(char *buf, char *raw, struct Line *line_info, int n,
           if (q_classify && line_info[n].quote == NULL)
             line_info[n].quote = classify_quote(quote_list, buf + pmatch[0].rm_so,
                                                 pmatch[0].rm_eo - pmatch[0].rm_so,
-                                                force_redraw, q_level);
+                                                force_redraw);
           line_info[n].type = MT_COLOR_QUOTED;
         }
         else
@@ -880,7 +1080,7 @@ static void resolve_types(char *buf, char *raw, struct Line *line_info, int n,
       if (q_classify && line_info[n].quote == NULL)
         line_info[n].quote = classify_quote(quote_list, buf + pmatch[0].rm_so,
                                             pmatch[0].rm_eo - pmatch[0].rm_so,
-                                            force_redraw, q_level);
+                                            force_redraw);
       line_info[n].type = MT_COLOR_QUOTED;
     }
   }
@@ -898,65 +1098,10 @@ static void resolve_types(char *buf, char *raw, struct Line *line_info, int n,
     if ((nl = mutt_strlen(buf)) > 0 && buf[nl - 1] == '\n')
       buf[nl - 1] = 0;
 
-    i = 0;
-    offset = 0;
-    line_info[n].chunks = 0;
-    do
-    {
-      if (!buf[offset])
-        break;
-
-      found = false;
-      null_rx = false;
-      struct ColorLineHead *head = NULL;
-      if (line_info[n].type == MT_COLOR_HDEFAULT)
-        head = &ColorHdrList;
-      else
-        head = &ColorBodyList;
-      STAILQ_FOREACH(color_line, head, entries)
-      {
-        if (regexec(&color_line->regex, buf + offset, 1, pmatch,
-                    (offset ? REG_NOTBOL : 0)) == 0)
-        {
-          if (pmatch[0].rm_eo != pmatch[0].rm_so)
-          {
-            if (!found)
-            {
-              /* Abort if we fill up chunks.
-               * Yes, this really happened. See #3888 */
-              if (line_info[n].chunks == SHRT_MAX)
-              {
-                null_rx = false;
-                break;
-              }
-              if (++(line_info[n].chunks) > 1)
-                safe_realloc(&(line_info[n].syntax),
-                             (line_info[n].chunks) * sizeof(struct Syntax));
-            }
-            i = line_info[n].chunks - 1;
-            pmatch[0].rm_so += offset;
-            pmatch[0].rm_eo += offset;
-            if (!found || pmatch[0].rm_so < (line_info[n].syntax)[i].first ||
-                (pmatch[0].rm_so == (line_info[n].syntax)[i].first &&
-                 pmatch[0].rm_eo > (line_info[n].syntax)[i].last))
-            {
-              (line_info[n].syntax)[i].color = color_line->pair;
-              (line_info[n].syntax)[i].first = pmatch[0].rm_so;
-              (line_info[n].syntax)[i].last = pmatch[0].rm_eo;
-            }
-            found = true;
-            null_rx = false;
-          }
-          else
-            null_rx = true; /* empty regex; don't add it, but keep looking */
-        }
-      }
-
-      if (null_rx)
-        offset++; /* avoid degenerate cases */
-      else
-        offset = (line_info[n].syntax)[i].last;
-    } while (found || null_rx);
+    if (line_info[n].type == MT_COLOR_HDEFAULT)
+      match_color_lines(buf, line_info, n, &ColorHdrList);
+    else
+      match_color_lines(buf, line_info, n, &ColorBodyList);
     if (nl > 0)
       buf[nl] = '\n';
   }
@@ -971,53 +1116,7 @@ static void resolve_types(char *buf, char *raw, struct Line *line_info, int n,
     if ((nl > 0) && (buf[nl - 1] == '\n'))
       buf[nl - 1] = 0;
 
-    i = 0;
-    offset = 0;
-    line_info[n].chunks = 0;
-    do
-    {
-      if (!buf[offset])
-        break;
-
-      found = false;
-      null_rx = false;
-      STAILQ_FOREACH(color_line, &ColorAttachList, entries)
-      {
-        if (regexec(&color_line->regex, buf + offset, 1, pmatch,
-                    (offset ? REG_NOTBOL : 0)) == 0)
-        {
-          if (pmatch[0].rm_eo != pmatch[0].rm_so)
-          {
-            if (!found)
-            {
-              if (++(line_info[n].chunks) > 1)
-                safe_realloc(&(line_info[n].syntax),
-                             (line_info[n].chunks) * sizeof(struct Syntax));
-            }
-            i = line_info[n].chunks - 1;
-            pmatch[0].rm_so += offset;
-            pmatch[0].rm_eo += offset;
-            if (!found || pmatch[0].rm_so < (line_info[n].syntax)[i].first ||
-                (pmatch[0].rm_so == (line_info[n].syntax)[i].first &&
-                 pmatch[0].rm_eo > (line_info[n].syntax)[i].last))
-            {
-              (line_info[n].syntax)[i].color = color_line->pair;
-              (line_info[n].syntax)[i].first = pmatch[0].rm_so;
-              (line_info[n].syntax)[i].last = pmatch[0].rm_eo;
-            }
-            found = 1;
-            null_rx = 0;
-          }
-          else
-            null_rx = 1; /* empty regex; don't add it, but keep looking */
-        }
-      }
-
-      if (null_rx)
-        offset++; /* avoid degenerate cases */
-      else
-        offset = (line_info[n].syntax)[i].last;
-    } while (found || null_rx);
+    match_color_lines(buf, line_info, n, &ColorAttachList);
     if (nl > 0)
       buf[nl] = '\n';
   }
@@ -1157,7 +1256,8 @@ static int fill_buffer(FILE *f, LOFF_T *last_pos, LOFF_T offset, unsigned char *
     *buf = (unsigned char *) mutt_read_line((char *) *buf, blen, f, &l, MUTT_EOL);
     if (!*buf)
     {
-      fmt[0] = 0;
+      if (*fmt)
+        **fmt = 0;
       return -1;
     }
     *last_pos = ftello(f);
@@ -1395,7 +1495,6 @@ static int format_line(struct Line **line_info, int n, unsigned char *buf, int f
  * @param max             Maximum number of lines
  * @param flags           See below
  * @param quote_list      Email quoting style
- * @param q_level         Level of quoting
  * @param force_redraw    Force a repaint
  * @param search_re       Regex to highlight
  * @param pager_window    Window to draw into
@@ -1414,11 +1513,12 @@ static int format_line(struct Line **line_info, int n, unsigned char *buf, int f
  */
 static int display_line(FILE *f, LOFF_T *last_pos, struct Line **line_info,
                         int n, int *last, int *max, int flags,
-                        struct QClass **quote_list, int *q_level, int *force_redraw,
-                        regex_t *search_re, struct MuttWindow *pager_window)
+                        struct QuoteList *quote_list, int *force_redraw,
+                        regex_t *search_re, const char *search_lit,
+                        bool search_icase, struct MuttWindow *pager_window)
 {
-  unsigned char *buf = NULL, *fmt = NULL;
-  size_t buflen = 0;
+  unsigned char *buf = LineBuffer.buf, *fmt = LineBuffer.fmt;
+  size_t buflen = LineBuffer.len;
   unsigned char *buf_ptr = buf;
   int ch, vch, col, cnt, b_read;
   int buf_ready = 0;
@@ -1439,7 +1539,8 @@ static int display_line(FILE *f, LOFF_T *last_pos, struct Line **line_info,
 
   if (*last == *max)
   {
-    safe_realloc(line_info, sizeof(struct Line) * (*max += LINES));
+    /* grow geometrically, so laying out a huge message isn't quadratic */
+    safe_realloc(line_info, sizeof(struct Line) * (*max += MAX(LINES, *max / 2)));
     for (ch = *last; ch < *max; ch++)
     {
       memset(&((*line_info)[ch]), 0, sizeof(struct Line));
@@ -1464,7 +1565,7 @@ static int display_line(FILE *f, LOFF_T *last_pos, struct Line **line_info,
       }
 
       resolve_types((char *) fmt, (char *) buf, *line_info, n, *last,
-                    quote_list, q_level, force_redraw, flags & MUTT_SHOWCOLOR);
+                    quote_list, force_redraw, flags & MUTT_SHOWCOLOR);
 
       /* avoid race condition for continuation lines when scrolling up */
       for (m = n + 1; m < *last && (*line_info)[m].offset && (*line_info)[m].continuation; m++)
@@ -1495,7 +1596,7 @@ static int display_line(FILE *f, LOFF_T *last_pos, struct Line **line_info,
       goto out;
     (*line_info)[n].quote =
         classify_quote(quote_list, (char *) fmt + pmatch[0].rm_so,
-                       pmatch[0].rm_eo - pmatch[0].rm_so, force_redraw, q_level);
+                       pmatch[0].rm_eo - pmatch[0].rm_so, force_redraw);
   }
 
   if ((flags & MUTT_SEARCH) && !(*line_info)[n].continuation &&
@@ -1510,7 +1611,11 @@ static int display_line(FILE *f, LOFF_T *last_pos, struct Line **line_info,
 
     offset = 0;
     (*line_info)[n].search_cnt = 0;
-    while (regexec(search_re, (char *) fmt + offset, 1, pmatch,
+    /* most lines don't contain the search's literal text */
+    if (search_lit && !(search_icase ? strcasestr((char *) fmt, search_lit) :
+                                       strstr((char *) fmt, search_lit)))
+      offset = -1;
+    while ((offset >= 0) && regexec(search_re, (char *) fmt + offset, 1, pmatch,
                    (offset ? REG_NOTBOL : 0)) == 0)
     {
       if (++((*line_info)[n].search_cnt) > 1)
@@ -1650,8 +1755,9 @@ static int display_line(FILE *f, LOFF_T *last_pos, struct Line **line_info,
   rc = flags;
 
 out:
-  FREE(&buf);
-  FREE(&fmt);
+  LineBuffer.buf = buf;
+  LineBuffer.fmt = fmt;
+  LineBuffer.len = buflen;
   return rc;
 }
 
@@ -1712,8 +1818,7 @@ struct PagerRedrawData
   int force_redraw;
   int has_types;
   int hide_quoted;
-  int q_level;
-  struct QClass *quote_list;
+  struct QuoteList quote_list;
   LOFF_T last_pos;
   LOFF_T last_offset;
   struct MuttWindow *index_status_window;
@@ -1722,6 +1827,8 @@ struct PagerRedrawData
   struct MuttWindow *pager_window;
   struct Menu *index; /**< the Pager Index (PI) */
   regex_t search_re;
+  char *search_literal; /**< text every search match contains, see mutt_regex_literal() */
+  bool search_icase;    /**< the search ignores case */
   int search_compiled;
   int search_flag;
   int search_back;
@@ -1754,6 +1861,7 @@ static void pager_menu_redraw(struct Menu *pager_menu)
     /* clear() doesn't optimize screen redraws */
     move(0, 0);
     clrtobot();
+    menu_screen_cleared();
 
     if (IsHeader(rd->extra) && Context && ((Context->vcount + 1) < PagerIndexLines))
       rd->indexlen = Context->vcount + 1;
@@ -1821,6 +1929,9 @@ static void pager_menu_redraw(struct Menu *pager_menu)
         {
           rd->search_flag = MUTT_SEARCH;
           rd->search_back = Resize->search_back;
+          rd->search_icase = (mutt_which_case(rd->searchbuf) == REG_ICASE);
+          FREE(&rd->search_literal);
+          rd->search_literal = mutt_regex_literal(rd->searchbuf);
         }
       }
       rd->lines = Resize->line;
@@ -1896,8 +2007,8 @@ static void pager_menu_redraw(struct Menu *pager_menu)
     j = -1;
     while (display_line(rd->fp, &rd->last_pos, &rd->line_info, ++i, &rd->last_line,
                         &rd->max_line, rd->has_types | rd->search_flag | (rd->flags & MUTT_PAGER_NOWRAP),
-                        &rd->quote_list, &rd->q_level, &rd->force_redraw,
-                        &rd->search_re, rd->pager_window) == 0)
+                        &rd->quote_list, &rd->force_redraw,
+                        &rd->search_re, rd->search_literal, rd->search_icase, rd->pager_window) == 0)
       if (!rd->line_info[i].continuation && ++j == rd->lines)
       {
         rd->topline = i;
@@ -1929,8 +2040,8 @@ static void pager_menu_redraw(struct Menu *pager_menu)
                          &rd->last_line, &rd->max_line,
                          (rd->flags & MUTT_DISPLAYFLAGS) | rd->hide_quoted |
                              rd->search_flag | (rd->flags & MUTT_PAGER_NOWRAP),
-                         &rd->quote_list, &rd->q_level, &rd->force_redraw,
-                         &rd->search_re, rd->pager_window) > 0)
+                         &rd->quote_list, &rd->force_redraw,
+                         &rd->search_re, rd->search_literal, rd->search_icase, rd->pager_window) > 0)
           rd->lines++;
         rd->curline++;
         mutt_window_move(rd->pager_window, rd->lines, 0);
@@ -2487,6 +2598,7 @@ int mutt_pager(const char *banner, const char *fname, int flags, struct Pager *e
         if (rd.search_compiled)
         {
           regfree(&rd.search_re);
+          FREE(&rd.search_literal);
           for (i = 0; i < rd.last_line; i++)
           {
             if (rd.line_info[i].search)
@@ -2513,12 +2625,14 @@ int mutt_pager(const char *banner, const char *fname, int flags, struct Pager *e
         else
         {
           rd.search_compiled = 1;
+          rd.search_icase = (mutt_which_case(searchbuf) == REG_ICASE);
+          rd.search_literal = mutt_regex_literal(searchbuf);
           /* update the search pointers */
           i = 0;
           while (display_line(rd.fp, &rd.last_pos, &rd.line_info, i, &rd.last_line, &rd.max_line,
                               MUTT_SEARCH | (flags & MUTT_PAGER_NSKIP) | (flags & MUTT_PAGER_NOWRAP),
-                              &rd.quote_list, &rd.q_level, &rd.force_redraw,
-                              &rd.search_re, rd.pager_window) == 0)
+                              &rd.quote_list, &rd.force_redraw,
+                              &rd.search_re, rd.search_literal, rd.search_icase, rd.pager_window) == 0)
             i++;
 
           if (!rd.search_back)
@@ -2624,8 +2738,8 @@ int mutt_pager(const char *banner, const char *fname, int flags, struct Pager *e
                     (0 == (dretval = display_line(
                                rd.fp, &rd.last_pos, &rd.line_info, new_topline, &rd.last_line,
                                &rd.max_line, MUTT_TYPES | (flags & MUTT_PAGER_NOWRAP),
-                               &rd.quote_list, &rd.q_level, &rd.force_redraw,
-                               &rd.search_re, rd.pager_window)))) &&
+                               &rd.quote_list, &rd.force_redraw,
+                               &rd.search_re, rd.search_literal, rd.search_icase, rd.pager_window)))) &&
                    ISHEADER(rd.line_info[new_topline].type))
             {
               new_topline++;
@@ -2638,8 +2752,8 @@ int mutt_pager(const char *banner, const char *fname, int flags, struct Pager *e
                   (0 == (dretval = display_line(
                              rd.fp, &rd.last_pos, &rd.line_info, new_topline, &rd.last_line,
                              &rd.max_line, MUTT_TYPES | (flags & MUTT_PAGER_NOWRAP),
-                             &rd.quote_list, &rd.q_level, &rd.force_redraw,
-                             &rd.search_re, rd.pager_window)))) &&
+                             &rd.quote_list, &rd.force_redraw,
+                             &rd.search_re, rd.search_literal, rd.search_icase, rd.pager_window)))) &&
                  rd.line_info[new_topline + SkipQuotedOffset].type != MT_COLOR_QUOTED)
             new_topline++;
 
@@ -2653,8 +2767,8 @@ int mutt_pager(const char *banner, const char *fname, int flags, struct Pager *e
                   (0 == (dretval = display_line(
                              rd.fp, &rd.last_pos, &rd.line_info, new_topline, &rd.last_line,
                              &rd.max_line, MUTT_TYPES | (flags & MUTT_PAGER_NOWRAP),
-                             &rd.quote_list, &rd.q_level, &rd.force_redraw,
-                             &rd.search_re, rd.pager_window)))) &&
+                             &rd.quote_list, &rd.force_redraw,
+                             &rd.search_re, rd.search_literal, rd.search_icase, rd.pager_window)))) &&
                  rd.line_info[new_topline + SkipQuotedOffset].type == MT_COLOR_QUOTED)
             new_topline++;
 
@@ -2674,8 +2788,8 @@ int mutt_pager(const char *banner, const char *fname, int flags, struct Pager *e
           /* make sure the types are defined to the end of file */
           while (display_line(rd.fp, &rd.last_pos, &rd.line_info, i, &rd.last_line,
                               &rd.max_line, rd.has_types | (flags & MUTT_PAGER_NOWRAP),
-                              &rd.quote_list, &rd.q_level, &rd.force_redraw,
-                              &rd.search_re, rd.pager_window) == 0)
+                              &rd.quote_list, &rd.force_redraw,
+                              &rd.search_re, rd.search_literal, rd.search_icase, rd.pager_window) == 0)
             i++;
           rd.topline = up_n_lines(rd.pager_window->rows, rd.line_info,
                                   rd.last_line, rd.hide_quoted);
@@ -3223,7 +3337,12 @@ int mutt_pager(const char *banner, const char *fname, int flags, struct Pager *e
     }
   }
 
-  cleanup_quote(&rd.quote_list);
+  cleanup_quote(&rd.quote_list.head);
+  hash_destroy(&rd.quote_list.prefixes, NULL);
+
+  FREE(&LineBuffer.buf);
+  FREE(&LineBuffer.fmt);
+  LineBuffer.len = 0;
 
   for (i = 0; i < rd.max_line; i++)
   {
@@ -3236,6 +3355,7 @@ int mutt_pager(const char *banner, const char *fname, int flags, struct Pager *e
     regfree(&rd.search_re);
     rd.search_compiled = 0;
   }
+  FREE(&rd.search_literal);
   FREE(&rd.line_info);
   mutt_pop_current_menu(pager_menu);
   mutt_menu_destroy(&pager_menu);
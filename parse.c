@@ -114,6 +114,154 @@ char *mutt_read_rfc822_line(FILE *f, char *line, size_t *linelen)
   /* not reached */
 }
 
+/**
+ * struct HeaderBlock - Header data read from a file in bulk
+ *
+ * The reader fetches more data than it needs, so the file position must be
+ * fixed up with header_block_finish() when it's done.
+ */
+struct HeaderBlock
+{
+  FILE *fp;
+  LOFF_T start; /**< file offset of data[0] */
+  char *data;   /**< bytes read from fp */
+  size_t len;   /**< number of bytes in data */
+  size_t size;  /**< allocated size of data */
+  size_t pos;   /**< offset of the first byte not consumed yet */
+};
+
+/**
+ * header_block_fill - Read more data into a HeaderBlock
+ * @param hb Header block
+ * @retval true if any data was read
+ */
+static bool header_block_fill(struct HeaderBlock *hb)
+{
+  if (hb->size < hb->len + STRING)
+  {
+    hb->size += LONG_STRING;
+    safe_realloc(&hb->data, hb->size);
+  }
+
+  size_t n = fread(hb->data + hb->len, 1, STRING, hb->fp);
+  hb->len += n;
+  return (n != 0);
+}
+
+/**
+ * header_block_peek - Look at a byte without consuming it
+ * @param hb  Header block
+ * @param off Offset into the block
+ * @retval num Byte at the offset
+ * @retval EOF if the file ends first
+ */
+static int header_block_peek(struct HeaderBlock *hb, size_t off)
+{
+  while (off >= hb->len)
+    if (!header_block_fill(hb))
+      return EOF;
+
+  return (unsigned char) hb->data[off];
+}
+
+/**
+ * header_block_line - Find the end of a physical line
+ * @param hb  Header block
+ * @param off Offset of the start of the line
+ * @retval num Offset just past the line's newline, or of the end of the file
+ */
+static size_t header_block_line(struct HeaderBlock *hb, size_t off)
+{
+  while (true)
+  {
+    char *nl = memchr(hb->data + off, '\n', hb->len - off);
+    if (nl)
+      return nl - hb->data + 1;
+
+    off = hb->len;
+    if (!header_block_fill(hb))
+      return hb->len;
+  }
+}
+
+/**
+ * header_block_field - Read a header field from a HeaderBlock
+ * @param hb      Header block
+ * @param line    Buffer for the field, may be reallocated
+ * @param linelen Size of the buffer
+ * @retval ptr The field, unfolded; empty at the end of the header
+ *
+ * This is mutt_read_rfc822_line(), working on data that has already been read.
+ */
+static char *header_block_field(struct HeaderBlock *hb, char *line, size_t *linelen)
+{
+  size_t offset = 0;
+
+  while (true)
+  {
+    size_t beg = hb->pos;
+    size_t end = header_block_line(hb, beg);
+
+    if ((beg == end) ||                           /* end of file or */
+        (ISSPACE(hb->data[beg]) && (offset == 0))) /* end of headers */
+    {
+      hb->pos = end;
+      *line = 0;
+      return line;
+    }
+    hb->pos = end;
+
+    /* Like fgets(), ignore anything after a NUL byte */
+    char *nul = memchr(hb->data + beg, '\0', end - beg);
+    size_t len = nul ? (size_t)(nul - (hb->data + beg)) : end - beg;
+    if (len == 0)
+    {
+      line[offset] = '\0';
+      return line;
+    }
+
+    if (*linelen < offset + len + STRING)
+    {
+      *linelen = offset + len + STRING;
+      safe_realloc(&line, *linelen);
+    }
+    memcpy(line + offset, hb->data + beg, len);
+    offset += len;
+    line[offset] = '\0';
+
+    if (line[offset - 1] == '\n')
+    {
+      /* we did get a full line. remove trailing space */
+      while ((offset > 0) && ISSPACE(line[offset - 1]))
+        line[--offset] = '\0';
+
+      /* check to see if the next line is a continuation line */
+      int ch = header_block_peek(hb, hb->pos);
+      if ((ch != ' ') && (ch != '\t'))
+        return line; /* next line is a separate header field or EOH */
+
+      /* eat tabs and spaces from the beginning of the continuation line */
+      while ((ch == ' ') || (ch == '\t'))
+        ch = header_block_peek(hb, ++hb->pos);
+
+      line[offset++] = ' ';
+      line[offset] = '\0';
+    }
+  }
+  /* not reached */
+}
+
+/**
+ * header_block_finish - Position the file after the consumed data
+ * @param hb Header block
+ */
+static void header_block_finish(struct HeaderBlock *hb)
+{
+  if (hb->pos != hb->len)
+    fseeko(hb->fp, hb->start + hb->pos, SEEK_SET);
+  FREE(&hb->data);
+}
+
 static void parse_references(struct ListHead *head, char *s)
 {
   char *m = NULL;
@@ -918,8 +1066,10 @@ int mutt_parse_rfc822_line(struct Envelope *e, struct Header *hdr, char *line,
             /* Take the first mailto URL */
             if (url_check_scheme(beg) == U_MAILTO)
             {
-              FREE(&e->list_post);
-              e->list_post = mutt_substrdup(beg, end);
+              char *list_post = mutt_substrdup(beg, end);
+              mutt_str_unintern(&e->list_post);
+              e->list_post = mutt_str_intern(list_post);
+              FREE(&list_post);
               break;
             }
           }
@@ -976,7 +1126,7 @@ int mutt_parse_rfc822_line(struct Envelope *e, struct Header *hdr, char *line,
       if (mutt_strcasecmp(line + 1, "rganization") == 0)
       {
         if (!e->organization && (mutt_strcasecmp(p, "unknown") != 0))
-          e->organization = safe_strdup(p);
+          e->organization = mutt_str_intern(p);
       }
       break;
 
@@ -1089,8 +1239,8 @@ int mutt_parse_rfc822_line(struct Envelope *e, struct Header *hdr, char *line,
       }
       else if (mutt_strcasecmp(line + 1, "-label") == 0)
       {
-        FREE(&e->x_label);
-        e->x_label = safe_strdup(p);
+        mutt_str_unintern(&e->x_label);
+        e->x_label = mutt_str_intern(p);
         matched = 1;
       }
 #ifdef USE_NNTP
@@ -1153,7 +1303,7 @@ struct Envelope *mutt_read_rfc822_header(FILE *f, struct Header *hdr,
   struct Envelope *e = mutt_new_envelope();
   char *line = safe_malloc(LONG_STRING);
   char *p = NULL;
-  LOFF_T loc;
+  size_t loc;
   size_t linelen = LONG_STRING;
   char buf[LONG_STRING + 1];
 
@@ -1174,9 +1324,15 @@ struct Envelope *mutt_read_rfc822_header(FILE *f, struct Header *hdr,
     }
   }
 
-  while ((loc = ftello(f)) != -1)
+  /* Read the header in blocks, rather than a line at a time */
+  struct HeaderBlock hb = { 0 };
+  hb.fp = f;
+  hb.start = ftello(f);
+
+  while (hb.start != -1)
   {
-    line = mutt_read_rfc822_line(f, line, &linelen);
+    loc = hb.pos;
+    line = header_block_field(&hb, line, &linelen);
     if (*line == '\0')
       break;
     if ((p = strpbrk(line, ": \t")) == NULL || *p != ':')
@@ -1195,7 +1351,7 @@ struct Envelope *mutt_read_rfc822_header(FILE *f, struct Header *hdr,
         continue;
       }
 
-      fseeko(f, loc, SEEK_SET);
+      hb.pos = loc;
       break; /* end of header */
     }
 
@@ -1249,6 +1405,8 @@ struct Envelope *mutt_read_rfc822_header(FILE *f, struct Header *hdr,
     mutt_parse_rfc822_line(e, hdr, line, p, user_hdrs, weed, 1);
   }
 
+  if (hb.start != -1)
+    header_block_finish(&hb);
   FREE(&line);
 
   if (hdr)
@@ -42,6 +42,7 @@
 #include "mutt.h"
 #include "address.h"
 #include "body.h"
+#include "bodyidx.h"
 #include "context.h"
 #include "copy.h"
 #include "envelope.h"
@@ -123,6 +124,8 @@ static bool eat_regex(struct Pattern *pat, struct Buffer *s, struct Buffer *err)
       FREE(&pat->p.regex);
       return false;
     }
+    pat->ign_case = mutt_which_case(buf.data) == REG_ICASE;
+    pat->literal = mutt_regex_literal(buf.data);
     FREE(&buf.data);
   }
 
@@ -919,17 +922,76 @@ static int patmatch(const struct Pattern *pat, const char *buf)
     return pat->ign_case ? !strcasestr(buf, pat->p.str) : !strstr(buf, pat->p.str);
   else if (pat->groupmatch)
     return !mutt_group_match(pat->p.g, buf);
+  else if (pat->literal && !(pat->ign_case ? strcasestr(buf, pat->literal) :
+                                               strstr(buf, pat->literal)))
+    return REG_NOMATCH;
   else
     return regexec(pat->p.regex, buf, 0, NULL, 0);
 }
 
-static int msg_search(struct Context *ctx, struct Pattern *pat, int msgno)
+#ifdef USE_HCACHE
+static struct BodyIndex *SearchIndex = NULL; /* body index of the folder being searched */
+
+/**
+ * pattern_needs_body - Does a pattern search message text?
+ * @param pat Pattern
+ * @retval true If any part of the pattern uses ~b, ~B or ~h
+ */
+static bool pattern_needs_body(const struct Pattern *pat)
+{
+  for (; pat; pat = pat->next)
+  {
+    if ((pat->op == MUTT_BODY) || (pat->op == MUTT_HEADER) || (pat->op == MUTT_WHOLE_MSG))
+      return true;
+    if (pattern_needs_body(pat->child))
+      return true;
+  }
+  return false;
+}
+#endif
+
+/**
+ * search_index_open - Prepare the body index for a search
+ * @param ctx Mailbox
+ * @param pat Pattern that will be executed
+ */
+static void search_index_open(struct Context *ctx, const struct Pattern *pat)
+{
+#ifdef USE_HCACHE
+  mutt_bodyidx_close(&SearchIndex);
+  if (pattern_needs_body(pat))
+    SearchIndex = mutt_bodyidx_open(ctx);
+#endif
+}
+
+/**
+ * search_index_close - Finish using the body index
+ */
+static void search_index_close(void)
+{
+#ifdef USE_HCACHE
+  mutt_bodyidx_close(&SearchIndex);
+#endif
+}
+
+/**
+ * msg_search_text - Search the text of a message
+ * @param ctx   Mailbox
+ * @param pat   Pattern, one of ~b, ~B, ~h
+ * @param msgno Message number
+ * @param sig   If not NULL, collect the signature of the whole text
+ * @retval  1 The message matches
+ * @retval  0 The message doesn't match
+ * @retval -1 The message couldn't be searched
+ */
+static int msg_search_text(struct Context *ctx, struct Pattern *pat, int msgno,
+                           struct BodySignature *sig)
 {
   struct Message *msg = NULL;
   struct State s;
   FILE *fp = NULL;
   long lng = 0;
-  int match = 0;
+  int match = -1;
   struct Header *h = ctx->hdrs[msgno];
   char *buf = NULL;
   size_t blen;
@@ -955,7 +1017,7 @@ static int msg_search(struct Context *ctx, struct Pattern *pat, int msgno)
       if (!s.fpout)
       {
         mutt_perror(_("Error opening memstream"));
-        return 0;
+        return -1;
       }
 #else
       mutt_mktemp(tempfile, sizeof(tempfile));
@@ -963,7 +1025,7 @@ static int msg_search(struct Context *ctx, struct Pattern *pat, int msgno)
       if (!s.fpout)
       {
         mutt_perror(tempfile);
-        return 0;
+        return -1;
       }
 #endif
 
@@ -986,7 +1048,7 @@ static int msg_search(struct Context *ctx, struct Pattern *pat, int msgno)
             unlink(tempfile);
 #endif
           }
-          return 0;
+          return -1;
         }
 
         fseeko(msg->fp, h->offset, SEEK_SET);
@@ -1003,7 +1065,7 @@ static int msg_search(struct Context *ctx, struct Pattern *pat, int msgno)
         if (!fp)
         {
           mutt_perror(_("Error re-opening memstream"));
-          return 0;
+          return -1;
         }
       }
       else
@@ -1012,7 +1074,7 @@ static int msg_search(struct Context *ctx, struct Pattern *pat, int msgno)
         if (!fp)
         {
           mutt_perror(_("Error opening /dev/null"));
-          return 0;
+          return -1;
         }
       }
 #else
@@ -1042,6 +1104,7 @@ static int msg_search(struct Context *ctx, struct Pattern *pat, int msgno)
 
     blen = STRING;
     buf = safe_malloc(blen);
+    match = 0;
 
     /* search the file "fp" */
     while (lng > 0)
@@ -1053,11 +1116,16 @@ static int msg_search(struct Context *ctx, struct Pattern *pat, int msgno)
       }
       else if (fgets(buf, blen - 1, fp) == NULL)
         break; /* don't loop forever */
-      if (patmatch(pat, buf) == 0)
+      if (!match && (patmatch(pat, buf) == 0))
       {
         match = 1;
-        break;
+        /* keep reading if we're indexing the whole message */
+        if (!sig)
+          break;
       }
+#ifdef USE_HCACHE
+      mutt_bodyidx_sig_add(sig, buf);
+#endif
       lng -= mutt_strlen(buf);
     }
 
@@ -1080,6 +1148,42 @@ static int msg_search(struct Context *ctx, struct Pattern *pat, int msgno)
   return match;
 }
 
+/**
+ * msg_search - Search a message, using the body index if possible
+ * @param ctx   Mailbox
+ * @param pat   Pattern, one of ~b, ~B, ~h
+ * @param msgno Message number
+ * @retval  1 The message matches
+ * @retval  0 The message doesn't match
+ * @retval -1 The message couldn't be searched
+ */
+static int msg_search(struct Context *ctx, struct Pattern *pat, int msgno)
+{
+#ifdef USE_HCACHE
+  struct BodySignature *sig = NULL;
+  struct Header *h = ctx->hdrs[msgno];
+
+  if (SearchIndex)
+  {
+    const char *literal = pat->stringmatch ? pat->p.str : pat->literal;
+    int rc = mutt_bodyidx_check(SearchIndex, ctx, h, pat->op, literal);
+    if (rc == 0)
+      return 0;
+    if (rc < 0)
+      sig = mutt_bodyidx_sig_new(h->content->length + h->content->offset - h->offset);
+  }
+
+  int match = msg_search_text(ctx, pat, msgno, sig);
+  if (sig && (match >= 0))
+    mutt_bodyidx_store(SearchIndex, ctx, h, pat->op, sig);
+  mutt_bodyidx_sig_free(&sig);
+#else
+  int match = msg_search_text(ctx, pat, msgno, NULL);
+#endif
+
+  return match;
+}
+
 static const struct PatternFlags *lookup_tag(char tag)
 {
   for (int i = 0; Flags[i].tag; i++)
@@ -1106,6 +1210,124 @@ static /* const */ char *find_matching_paren(/* const */ char *s)
   return s;
 }
 
+static unsigned int MemoGeneration = 1; /* bumped to invalidate all memoized results */
+static bool *MemoSlots = NULL;          /* which memo slots are in use */
+static int MemoSlotsMax = 0;
+
+/**
+ * memo_slot_alloc - Reserve a memo slot for a pattern
+ * @retval num Slot number, greater than zero
+ */
+static int memo_slot_alloc(void)
+{
+  int slot;
+
+  for (slot = 0; slot < MemoSlotsMax; slot++)
+    if (!MemoSlots[slot])
+      break;
+
+  if (slot == MemoSlotsMax)
+  {
+    MemoSlotsMax += 32;
+    safe_realloc(&MemoSlots, MemoSlotsMax * sizeof(bool));
+    memset(MemoSlots + slot, 0, (MemoSlotsMax - slot) * sizeof(bool));
+  }
+
+  MemoSlots[slot] = true;
+  return slot + 1;
+}
+
+/**
+ * memo_slot_free - Release a memo slot
+ * @param slot Slot number from memo_slot_alloc()
+ *
+ * The slot may be reused by a different pattern, so any results that have
+ * been memoized for it are discarded.
+ */
+static void memo_slot_free(int slot)
+{
+  if ((slot < 1) || (slot > MemoSlotsMax))
+    return;
+
+  MemoSlots[slot - 1] = false;
+  mutt_pattern_memo_invalidate(NULL);
+}
+
+/**
+ * is_memoizable - Can the result of a pattern be memoized?
+ * @param op Pattern operation, e.g. #MUTT_SUBJECT
+ * @retval true If the result only depends on the message's envelope or content
+ *
+ * Flags, scores, tags and the thread tree change too often to be worth it.
+ * They are cheap to test, so e.g. an index colour rule that depends on flags
+ * and the body only re-reads the body when the memo has been invalidated.
+ */
+static bool is_memoizable(int op)
+{
+  switch (op)
+  {
+    case MUTT_SENDER:
+    case MUTT_FROM:
+    case MUTT_TO:
+    case MUTT_CC:
+    case MUTT_SUBJECT:
+    case MUTT_ID:
+    case MUTT_REFERENCE:
+    case MUTT_ADDRESS:
+    case MUTT_RECIPIENT:
+    case MUTT_LIST:
+    case MUTT_SUBSCRIBED_LIST:
+    case MUTT_PERSONAL_RECIP:
+    case MUTT_PERSONAL_FROM:
+    case MUTT_XLABEL:
+    case MUTT_HORMEL:
+#ifdef USE_NNTP
+    case MUTT_NEWSGROUPS:
+#endif
+    case MUTT_BODY:
+    case MUTT_HEADER:
+    case MUTT_WHOLE_MSG:
+    case MUTT_MIMEATTACH:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * pattern_memo_assign - Give memo slots to the memoizable parts of a pattern
+ * @param pat Pattern
+ */
+static void pattern_memo_assign(struct Pattern *pat)
+{
+  for (; pat; pat = pat->next)
+  {
+    if (!pat->memo && is_memoizable(pat->op))
+      pat->memo = memo_slot_alloc();
+    pattern_memo_assign(pat->child);
+  }
+}
+
+/**
+ * mutt_pattern_memo_invalidate - Forget memoized pattern results
+ * @param h Email Header, or NULL for all emails
+ *
+ * This must be called when a message's envelope changes, or when the config
+ * changes in a way that could affect the result of a pattern.
+ */
+void mutt_pattern_memo_invalidate(struct Header *h)
+{
+  if (h)
+  {
+    h->memo_gen = 0;
+    return;
+  }
+
+  MemoGeneration++;
+  if (MemoGeneration == 0)
+    MemoGeneration = 1;
+}
+
 void mutt_pattern_free(struct Pattern **pat)
 {
   struct Pattern *tmp = NULL;
@@ -1124,6 +1346,8 @@ void mutt_pattern_free(struct Pattern **pat)
       regfree(tmp->p.regex);
       FREE(&tmp->p.regex);
     }
+    FREE(&tmp->literal);
+    memo_slot_free(tmp->memo);
 
     if (tmp->child)
       mutt_pattern_free(&tmp->child);
@@ -1361,23 +1585,25 @@ struct Pattern *mutt_pattern_comp(/* const */ char *s, int flags, struct Buffer
     tmp->child = curlist;
     curlist = tmp;
   }
+  if (flags & MUTT_PATTERN_MEMO)
+    pattern_memo_assign(curlist);
   return curlist;
 }
 
 static bool perform_and(struct Pattern *pat, enum PatternExecFlag flags,
-                        struct Context *ctx, struct Header *hdr, struct PatternCache *cache)
+                        struct Context *ctx, struct Header *hdr)
 {
   for (; pat; pat = pat->next)
-    if (mutt_pattern_exec(pat, flags, ctx, hdr, cache) <= 0)
+    if (mutt_pattern_exec(pat, flags, ctx, hdr) <= 0)
       return false;
   return true;
 }
 
 static int perform_or(struct Pattern *pat, enum PatternExecFlag flags,
-                      struct Context *ctx, struct Header *hdr, struct PatternCache *cache)
+                      struct Context *ctx, struct Header *hdr)
 {
   for (; pat; pat = pat->next)
-    if (mutt_pattern_exec(pat, flags, ctx, hdr, cache) > 0)
+    if (mutt_pattern_exec(pat, flags, ctx, hdr) > 0)
       return true;
   return false;
 }
@@ -1468,7 +1694,7 @@ static int match_threadcomplete(struct Pattern *pat, enum PatternExecFlag flags,
     return 0;
   h = t->message;
   if (h)
-    if (mutt_pattern_exec(pat, flags, ctx, h, NULL))
+    if (mutt_pattern_exec(pat, flags, ctx, h))
       return 1;
 
   if (up && (a = match_threadcomplete(pat, flags, ctx, t->parent, 1, 1, 1, 0)))
@@ -1490,7 +1716,7 @@ static int match_threadparent(struct Pattern *pat, enum PatternExecFlag flags,
   if (!t || !t->parent || !t->parent->message)
     return 0;
 
-  return mutt_pattern_exec(pat, flags, ctx, t->parent->message, NULL);
+  return mutt_pattern_exec(pat, flags, ctx, t->parent->message);
 }
 
 static int match_threadchildren(struct Pattern *pat, enum PatternExecFlag flags,
@@ -1500,56 +1726,110 @@ static int match_threadchildren(struct Pattern *pat, enum PatternExecFlag flags,
     return 0;
 
   for (t = t->child; t; t = t->next)
-    if (t->message && mutt_pattern_exec(pat, flags, ctx, t->message, NULL))
+    if (t->message && mutt_pattern_exec(pat, flags, ctx, t->message))
       return 1;
 
   return 0;
 }
 
 /**
- * set_pattern_cache_value - Sets a value in the PatternCache cache entry
- *
- * Normalizes the "true" value to 2.
+ * match_envelope - Match a pattern against the envelope of an email
+ * @param pat   Pattern, see is_memoizable()
+ * @param flags Flags, e.g. #MUTT_MATCH_FULL_ADDRESS
+ * @param h     Email Header
+ * @retval true If the envelope matches (ignoring pat->not)
  */
-static void set_pattern_cache_value(int *cache_entry, int value)
+static bool match_envelope(struct Pattern *pat, enum PatternExecFlag flags, struct Header *h)
 {
-  *cache_entry = value ? 2 : 1;
+  switch (pat->op)
+  {
+    case MUTT_SENDER:
+      return match_adrlist(pat, flags & MUTT_MATCH_FULL_ADDRESS, 1, h->env->sender);
+    case MUTT_FROM:
+      return match_adrlist(pat, flags & MUTT_MATCH_FULL_ADDRESS, 1, h->env->from);
+    case MUTT_TO:
+      return match_adrlist(pat, flags & MUTT_MATCH_FULL_ADDRESS, 1, h->env->to);
+    case MUTT_CC:
+      return match_adrlist(pat, flags & MUTT_MATCH_FULL_ADDRESS, 1, h->env->cc);
+    case MUTT_SUBJECT:
+      return (h->env->subject && patmatch(pat, h->env->subject) == 0);
+    case MUTT_ID:
+      return (h->env->message_id && patmatch(pat, h->env->message_id) == 0);
+    case MUTT_REFERENCE:
+      return (match_reference(pat, &h->env->references) ||
+              match_reference(pat, &h->env->in_reply_to));
+    case MUTT_ADDRESS:
+      return match_adrlist(pat, flags & MUTT_MATCH_FULL_ADDRESS, 4, h->env->from,
+                           h->env->sender, h->env->to, h->env->cc);
+    case MUTT_RECIPIENT:
+      return match_adrlist(pat, flags & MUTT_MATCH_FULL_ADDRESS, 2, h->env->to, h->env->cc);
+    case MUTT_LIST: /* known list, subscribed or not */
+      return mutt_is_list_cc(pat->alladdr, h->env->to, h->env->cc);
+    case MUTT_SUBSCRIBED_LIST:
+      return mutt_is_list_recipient(pat->alladdr, h->env->to, h->env->cc);
+    case MUTT_PERSONAL_RECIP:
+      return match_user(pat->alladdr, h->env->to, h->env->cc);
+    case MUTT_PERSONAL_FROM:
+      return match_user(pat->alladdr, h->env->from, NULL);
+    case MUTT_XLABEL:
+      return (h->env->x_label && patmatch(pat, h->env->x_label) == 0);
+    case MUTT_HORMEL:
+      return (h->env->spam && h->env->spam->data && patmatch(pat, h->env->spam->data) == 0);
+#ifdef USE_NNTP
+    case MUTT_NEWSGROUPS:
+      return (h->env->newsgroups && patmatch(pat, h->env->newsgroups) == 0);
+#endif
+  }
+  return false;
 }
 
 /**
- * get_pattern_cache_value - Get pattern cache value
- * @retval 1 if the cache value is set and has a true value
- * @retval 0 otherwise (even if unset!)
+ * memo_entry - Find the memoized result of a pattern for a message
+ * @param pat   Pattern with a memo slot
+ * @param flags Flags passed to mutt_pattern_exec()
+ * @param h     Email Header
+ * @retval ptr Memo entry: 0 = unset, 1 = false, 2 = true
  */
-static int get_pattern_cache_value(int cache_entry)
+static unsigned char *memo_entry(const struct Pattern *pat,
+                                 enum PatternExecFlag flags, struct Header *h)
 {
-  return cache_entry == 2;
-}
+  size_t idx = (pat->memo - 1) * 2 + ((flags & MUTT_MATCH_FULL_ADDRESS) ? 1 : 0);
 
-static int is_pattern_cache_set(int cache_entry)
-{
-  return cache_entry != 0;
+  if (h->memo_gen != MemoGeneration)
+  {
+    memset(h->memo, 0, h->memo_len);
+    h->memo_gen = MemoGeneration;
+  }
+
+  if (idx >= h->memo_len)
+  {
+    size_t len = MemoSlotsMax * 2;
+    safe_realloc(&h->memo, len);
+    memset(h->memo + h->memo_len, 0, len - h->memo_len);
+    h->memo_len = len;
+  }
+
+  return &h->memo[idx];
 }
 
 /**
  * mutt_pattern_exec - Match a pattern against an email header
  *
  * flags: MUTT_MATCH_FULL_ADDRESS - match both personal and machine address
- * cache: For repeated matches against the same Header, passing in non-NULL will
- *        store some of the cacheable pattern matches in this structure.
+ *
+ * If the pattern was compiled with #MUTT_PATTERN_MEMO, the results of its
+ * envelope tests are remembered in the Header, for the next time the same
+ * message is matched against it, e.g. for color, scoring and hooks.
  */
 int mutt_pattern_exec(struct Pattern *pat, enum PatternExecFlag flags,
-                      struct Context *ctx, struct Header *h, struct PatternCache *cache)
+                      struct Context *ctx, struct Header *h)
 {
-  int result;
-  int *cache_entry = NULL;
-
   switch (pat->op)
   {
     case MUTT_AND:
-      return (pat->not ^ (perform_and(pat->child, flags, ctx, h, cache) > 0));
+      return (pat->not ^ (perform_and(pat->child, flags, ctx, h) > 0));
     case MUTT_OR:
-      return (pat->not ^ (perform_or(pat->child, flags, ctx, h, cache) > 0));
+      return (pat->not ^ (perform_or(pat->child, flags, ctx, h) > 0));
     case MUTT_THREAD:
       return (pat->not ^
               match_threadcomplete(pat->child, flags, ctx, h->thread, 1, 1, 1, 1));
@@ -1600,7 +1880,20 @@ int mutt_pattern_exec(struct Pattern *pat, enum PatternExecFlag flags,
       if (ctx->magic == MUTT_IMAP && pat->stringmatch)
         return h->matched;
 #endif
-      return (pat->not ^ msg_search(ctx, pat, h->msgno));
+      if (pat->memo)
+      {
+        unsigned char *entry = memo_entry(pat, flags, h);
+        if (*entry == 0)
+        {
+          int match = msg_search(ctx, pat, h->msgno);
+          /* Don't remember a failure to read the message, try again next time */
+          if (match < 0)
+            return pat->not;
+          *entry = match ? 2 : 1;
+        }
+        return (pat->not ^ (*entry == 2));
+      }
+      return (pat->not ^ (msg_search(ctx, pat, h->msgno) > 0));
     case MUTT_SERVERSEARCH:
 #ifdef USE_IMAP
       if (!ctx)
@@ -1618,85 +1911,37 @@ int mutt_pattern_exec(struct Pattern *pat, enum PatternExecFlag flags,
       return -1;
 #endif
     case MUTT_SENDER:
-      return (pat->not ^ match_adrlist(pat, flags & MUTT_MATCH_FULL_ADDRESS, 1,
-                                       h->env->sender));
     case MUTT_FROM:
-      return (pat->not ^
-              match_adrlist(pat, flags & MUTT_MATCH_FULL_ADDRESS, 1, h->env->from));
     case MUTT_TO:
-      return (pat->not ^
-              match_adrlist(pat, flags & MUTT_MATCH_FULL_ADDRESS, 1, h->env->to));
     case MUTT_CC:
-      return (pat->not ^
-              match_adrlist(pat, flags & MUTT_MATCH_FULL_ADDRESS, 1, h->env->cc));
     case MUTT_SUBJECT:
-      return (pat->not ^ (h->env->subject && patmatch(pat, h->env->subject) == 0));
     case MUTT_ID:
-      return (pat->not ^ (h->env->message_id && patmatch(pat, h->env->message_id) == 0));
-    case MUTT_SCORE:
-      return (pat->not ^ (h->score >= pat->min &&
-                          (pat->max == MUTT_MAXRANGE || h->score <= pat->max)));
-    case MUTT_SIZE:
-      return (pat->not ^ (h->content->length >= pat->min &&
-                          (pat->max == MUTT_MAXRANGE || h->content->length <= pat->max)));
     case MUTT_REFERENCE:
-      return (pat->not ^ (match_reference(pat, &h->env->references) ||
-                          match_reference(pat, &h->env->in_reply_to)));
     case MUTT_ADDRESS:
-      return (pat->not ^ match_adrlist(pat, flags & MUTT_MATCH_FULL_ADDRESS, 4,
-                                       h->env->from, h->env->sender, h->env->to,
-                                       h->env->cc));
     case MUTT_RECIPIENT:
-      return (pat->not ^ match_adrlist(pat, flags & MUTT_MATCH_FULL_ADDRESS, 2,
-                                       h->env->to, h->env->cc));
-    case MUTT_LIST: /* known list, subscribed or not */
-      if (cache)
-      {
-        cache_entry = pat->alladdr ? &cache->list_all : &cache->list_one;
-        if (!is_pattern_cache_set(*cache_entry))
-          set_pattern_cache_value(
-              cache_entry, mutt_is_list_cc(pat->alladdr, h->env->to, h->env->cc));
-        result = get_pattern_cache_value(*cache_entry);
-      }
-      else
-        result = mutt_is_list_cc(pat->alladdr, h->env->to, h->env->cc);
-      return (pat->not ^ result);
+    case MUTT_LIST:
     case MUTT_SUBSCRIBED_LIST:
-      if (cache)
-      {
-        cache_entry = pat->alladdr ? &cache->sub_all : &cache->sub_one;
-        if (!is_pattern_cache_set(*cache_entry))
-          set_pattern_cache_value(
-              cache_entry,
-              mutt_is_list_recipient(pat->alladdr, h->env->to, h->env->cc));
-        result = get_pattern_cache_value(*cache_entry);
-      }
-      else
-        result = mutt_is_list_recipient(pat->alladdr, h->env->to, h->env->cc);
-      return (pat->not ^ result);
     case MUTT_PERSONAL_RECIP:
-      if (cache)
-      {
-        cache_entry = pat->alladdr ? &cache->pers_recip_all : &cache->pers_recip_one;
-        if (!is_pattern_cache_set(*cache_entry))
-          set_pattern_cache_value(cache_entry,
-                                  match_user(pat->alladdr, h->env->to, h->env->cc));
-        result = get_pattern_cache_value(*cache_entry);
-      }
-      else
-        result = match_user(pat->alladdr, h->env->to, h->env->cc);
-      return (pat->not ^ result);
     case MUTT_PERSONAL_FROM:
-      if (cache)
+    case MUTT_XLABEL:
+    case MUTT_HORMEL:
+#ifdef USE_NNTP
+    case MUTT_NEWSGROUPS:
+#endif
+      if (pat->memo)
       {
-        cache_entry = pat->alladdr ? &cache->pers_from_all : &cache->pers_from_one;
-        if (!is_pattern_cache_set(*cache_entry))
-          set_pattern_cache_value(cache_entry, match_user(pat->alladdr, h->env->from, NULL));
-        result = get_pattern_cache_value(*cache_entry);
+        unsigned char *entry = memo_entry(pat, flags, h);
+        if (*entry == 0)
+          *entry = match_envelope(pat, flags, h) ? 2 : 1;
+        return (pat->not ^ (*entry == 2));
       }
-      else
-        result = match_user(pat->alladdr, h->env->from, NULL);
-      return (pat->not ^ result);
+      return (pat->not ^ match_envelope(pat, flags, h));
+    case MUTT_SCORE:
+      return (pat->not ^ (h->score >= pat->min &&
+                          (pat->max == MUTT_MAXRANGE || h->score <= pat->max)));
+    case MUTT_SIZE:
+      return (pat->not ^ (h->content->length >= pat->min &&
+                          (pat->max == MUTT_MAXRANGE || h->content->length <= pat->max)));
     case MUTT_COLLAPSED:
       return (pat->not ^ (h->collapsed && h->num_hidden > 1));
     case MUTT_CRYPT_SIGN:
@@ -1715,8 +1960,6 @@ int mutt_pattern_exec(struct Pattern *pat, enum PatternExecFlag flags,
       if (!(WithCrypto & APPLICATION_PGP))
         break;
       return (pat->not ^ ((h->security & APPLICATION_PGP) && (h->security & PGPKEY)));
-    case MUTT_XLABEL:
-      return (pat->not ^ (h->env->x_label && patmatch(pat, h->env->x_label) == 0));
     case MUTT_DRIVER_TAGS:
     {
       char *tags = driver_tags_get(&h->tags);
@@ -1724,27 +1967,27 @@ int mutt_pattern_exec(struct Pattern *pat, enum PatternExecFlag flags,
       FREE(&tags);
       return ret;
     }
-    case MUTT_HORMEL:
-      return (pat->not ^ (h->env->spam && h->env->spam->data &&
-                          patmatch(pat, h->env->spam->data) == 0));
     case MUTT_DUPLICATED:
       return (pat->not ^ (h->thread && h->thread->duplicate_thread));
     case MUTT_MIMEATTACH:
       if (!ctx)
         return 0;
       {
-        int count = mutt_count_body_parts(ctx, h);
-        return (pat->not ^ (count >= pat->min &&
-                            (pat->max == MUTT_MAXRANGE || count <= pat->max)));
+        unsigned char *entry = pat->memo ? memo_entry(pat, flags, h) : NULL;
+        if (!entry || (*entry == 0))
+        {
+          int count = mutt_count_body_parts(ctx, h);
+          bool match = (count >= pat->min && (pat->max == MUTT_MAXRANGE || count <= pat->max));
+          if (!entry)
+            return (pat->not ^ match);
+          *entry = match ? 2 : 1;
+        }
+        return (pat->not ^ (*entry == 2));
       }
     case MUTT_UNREFERENCED:
       return (pat->not ^ (h->thread && !h->thread->child));
     case MUTT_BROKEN:
       return (pat->not ^ (h->thread && h->thread->fake_thread));
-#ifdef USE_NNTP
-    case MUTT_NEWSGROUPS:
-      return (pat->not ^ (h->env->newsgroups && patmatch(pat, h->env->newsgroups) == 0));
-#endif
   }
   mutt_error(_("error: unknown op %d (report this error)."), pat->op);
   return -1;
@@ -1881,12 +2124,214 @@ bool mutt_limit_current_thread(struct Header *h)
   return true;
 }
 
+/**
+ * struct RangeIndex - Messages sorted by date, for ~d and ~r
+ *
+ * The index is built the first time a date pattern is used to limit or tag
+ * messages, and rebuilt whenever the mailbox's messages change.
+ */
+struct RangeIndex
+{
+  int msgcount;         /**< Number of messages indexed */
+  struct Header **hdrs; /**< Copy of ctx->hdrs, to detect changes */
+  int *by_sent;         /**< Message numbers, sorted by date_sent */
+  int *by_received;     /**< Message numbers, sorted by received */
+};
+
+static struct Header **RangeSortHdrs = NULL; /* headers being sorted, for the qsort() callbacks */
+
+static int range_cmp_sent(const void *a, const void *b)
+{
+  time_t ta = RangeSortHdrs[*(const int *) a]->date_sent;
+  time_t tb = RangeSortHdrs[*(const int *) b]->date_sent;
+  return (ta > tb) - (ta < tb);
+}
+
+static int range_cmp_received(const void *a, const void *b)
+{
+  time_t ta = RangeSortHdrs[*(const int *) a]->received;
+  time_t tb = RangeSortHdrs[*(const int *) b]->received;
+  return (ta > tb) - (ta < tb);
+}
+
+void mutt_range_index_free(struct RangeIndex **ri)
+{
+  if (!ri || !*ri)
+    return;
+
+  FREE(&(*ri)->hdrs);
+  FREE(&(*ri)->by_sent);
+  FREE(&(*ri)->by_received);
+  FREE(ri);
+}
+
+/**
+ * range_index_get - Get an up to date RangeIndex for a mailbox
+ * @param ctx Mailbox
+ * @retval ptr RangeIndex
+ */
+static struct RangeIndex *range_index_get(struct Context *ctx)
+{
+  struct RangeIndex *ri = ctx->range_index;
+  size_t hsize = ctx->msgcount * sizeof(struct Header *);
+
+  if (ri && (ri->msgcount == ctx->msgcount) && (memcmp(ri->hdrs, ctx->hdrs, hsize) == 0))
+    return ri;
+
+  mutt_range_index_free(&ctx->range_index);
+
+  ri = safe_calloc(1, sizeof(struct RangeIndex));
+  ri->msgcount = ctx->msgcount;
+  ri->hdrs = safe_malloc(hsize ? hsize : 1);
+  memcpy(ri->hdrs, ctx->hdrs, hsize);
+  ri->by_sent = safe_calloc(ctx->msgcount ? ctx->msgcount : 1, sizeof(int));
+  ri->by_received = safe_calloc(ctx->msgcount ? ctx->msgcount : 1, sizeof(int));
+  for (int i = 0; i < ctx->msgcount; i++)
+    ri->by_sent[i] = ri->by_received[i] = i;
+
+  RangeSortHdrs = ctx->hdrs;
+  qsort(ri->by_sent, ctx->msgcount, sizeof(int), range_cmp_sent);
+  qsort(ri->by_received, ctx->msgcount, sizeof(int), range_cmp_received);
+  RangeSortHdrs = NULL;
+
+  ctx->range_index = ri;
+  return ri;
+}
+
+/**
+ * range_lower_bound - Find the first message on or after a date
+ * @param ctx      Mailbox
+ * @param sorted   Message numbers, sorted by date
+ * @param received If true, use the received date, otherwise the sent date
+ * @param t        Date
+ * @retval num Position in sorted
+ */
+static int range_lower_bound(struct Context *ctx, const int *sorted, bool received, time_t t)
+{
+  int lo = 0, hi = ctx->msgcount;
+
+  while (lo < hi)
+  {
+    int mid = lo + (hi - lo) / 2;
+    struct Header *h = ctx->hdrs[sorted[mid]];
+    if ((received ? h->received : h->date_sent) < t)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+/**
+ * range_pattern_bits - Find the messages matching a single ~d, ~r or ~z
+ * @param ctx  Mailbox
+ * @param pat  Pattern
+ * @param bits Bitset, one bit per message, to store the result in
+ * @retval true  If the pattern is a range pattern
+ * @retval false Otherwise; bits is unchanged
+ *
+ * Dates are looked up in the RangeIndex.  Sizes aren't indexed, because they
+ * change when the body of a message is downloaded, so they're scanned.
+ */
+static bool range_pattern_bits(struct Context *ctx, const struct Pattern *pat,
+                               unsigned char *bits)
+{
+  size_t nbytes = (ctx->msgcount + 7) / 8;
+
+  if ((pat->op == MUTT_DATE) || (pat->op == MUTT_DATE_RECEIVED))
+  {
+    struct RangeIndex *ri = range_index_get(ctx);
+    bool received = (pat->op == MUTT_DATE_RECEIVED);
+    const int *sorted = received ? ri->by_received : ri->by_sent;
+
+    int first = range_lower_bound(ctx, sorted, received, pat->min);
+    int last = range_lower_bound(ctx, sorted, received, (time_t) pat->max + 1);
+
+    memset(bits, 0, nbytes);
+    for (int i = first; i < last; i++)
+      mutt_bit_set(bits, sorted[i]);
+  }
+  else if (pat->op == MUTT_SIZE)
+  {
+    memset(bits, 0, nbytes);
+    for (int i = 0; i < ctx->msgcount; i++)
+    {
+      LOFF_T len = ctx->hdrs[i]->content->length;
+      if ((len >= pat->min) && ((pat->max == MUTT_MAXRANGE) || (len <= pat->max)))
+        mutt_bit_set(bits, i);
+    }
+  }
+  else
+    return false;
+
+  if (pat->not)
+    for (size_t i = 0; i < nbytes; i++)
+      bits[i] = ~bits[i];
+
+  return true;
+}
+
+/**
+ * range_filter - Find the messages that can match a pattern by date or size
+ * @param[in]  ctx   Mailbox
+ * @param[in]  pat   Compiled pattern
+ * @param[out] exact Set to true if the result is exact
+ * @retval ptr  Bitset, one bit per message; messages not set can't match
+ * @retval NULL If the pattern doesn't have a date or size condition
+ *
+ * This handles a single ~d, ~r or ~z, and an "and" of conditions containing
+ * them.  If all the conditions are ranges, the bitset is exactly the set of
+ * matching messages.  The caller must free the bitset.
+ */
+static unsigned char *range_filter(struct Context *ctx, const struct Pattern *pat, bool *exact)
+{
+  size_t nbytes = (ctx->msgcount + 7) / 8;
+  unsigned char *bits = safe_calloc(1, nbytes ? nbytes : 1);
+
+  *exact = false;
+  if (range_pattern_bits(ctx, pat, bits))
+  {
+    *exact = true;
+    return bits;
+  }
+
+  if ((pat->op != MUTT_AND) || pat->not)
+  {
+    FREE(&bits);
+    return NULL;
+  }
+
+  unsigned char *child = safe_calloc(1, nbytes ? nbytes : 1);
+  bool found = false;
+  *exact = true;
+  for (const struct Pattern *p = pat->child; p; p = p->next)
+  {
+    if (!range_pattern_bits(ctx, p, found ? child : bits))
+    {
+      *exact = false;
+      continue;
+    }
+    if (found)
+      for (size_t i = 0; i < nbytes; i++)
+        bits[i] &= child[i];
+    found = true;
+  }
+  FREE(&child);
+
+  if (!found)
+    FREE(&bits);
+  return bits;
+}
+
 int mutt_pattern_func(int op, char *prompt)
 {
   struct Pattern *pat = NULL;
   char buf[LONG_STRING] = "", *simple = NULL;
   struct Buffer err;
   struct Progress progress;
+  unsigned char *candidates = NULL;
+  bool exact = false;
+  bool match;
 
   strfcpy(buf, NONULL(Context->pattern), sizeof(buf));
   if (prompt || op != MUTT_LIMIT)
@@ -1918,6 +2363,8 @@ int mutt_pattern_func(int op, char *prompt)
   mutt_progress_init(&progress, _("Executing command on matching messages..."),
                      MUTT_PROGRESS_MSG, ReadInc,
                      (op == MUTT_LIMIT) ? Context->msgcount : Context->vcount);
+  search_index_open(Context, pat);
+  candidates = range_filter(Context, pat, &exact);
 
   if (op == MUTT_LIMIT)
   {
@@ -1933,7 +2380,13 @@ int mutt_pattern_func(int op, char *prompt)
       Context->hdrs[i]->limited = false;
       Context->hdrs[i]->collapsed = false;
       Context->hdrs[i]->num_hidden = 0;
-      if (mutt_pattern_exec(pat, MUTT_MATCH_FULL_ADDRESS, Context, Context->hdrs[i], NULL))
+      if (candidates && !mutt_bit_isset(candidates, i))
+        match = false;
+      else if (candidates && exact)
+        match = true;
+      else
+        match = mutt_pattern_exec(pat, MUTT_MATCH_FULL_ADDRESS, Context, Context->hdrs[i]);
+      if (match)
       {
         Context->hdrs[i]->virtual = Context->vcount;
         Context->hdrs[i]->limited = true;
@@ -1949,8 +2402,14 @@ int mutt_pattern_func(int op, char *prompt)
     for (int i = 0; i < Context->vcount; i++)
     {
       mutt_progress_update(&progress, i, -1);
-      if (mutt_pattern_exec(pat, MUTT_MATCH_FULL_ADDRESS, Context,
-                            Context->hdrs[Context->v2r[i]], NULL))
+      if (candidates && !mutt_bit_isset(candidates, Context->v2r[i]))
+        match = false;
+      else if (candidates && exact)
+        match = true;
+      else
+        match = mutt_pattern_exec(pat, MUTT_MATCH_FULL_ADDRESS, Context,
+                                  Context->hdrs[Context->v2r[i]]);
+      if (match)
       {
         switch (op)
         {
@@ -1970,6 +2429,8 @@ int mutt_pattern_func(int op, char *prompt)
     }
   }
 
+  search_index_close();
+  FREE(&candidates);
   mutt_clear_error();
 
   if (op == MUTT_LIMIT)
@@ -2005,6 +2466,7 @@ int mutt_search_command(int cur, int op)
   struct Header *h = NULL;
   struct Progress progress;
   const char *msg = NULL;
+  int rc = -1;
 
   if (!*LastSearch || (op != OP_SEARCH_NEXT && op != OP_SEARCH_OPPOSITE))
   {
@@ -2065,6 +2527,7 @@ int mutt_search_command(int cur, int op)
 
   mutt_progress_init(&progress, _("Searching..."), MUTT_PROGRESS_MSG, ReadInc,
                      Context->vcount);
+  search_index_open(Context, SearchPattern);
 
   for (int i = cur + incr, j = 0; j != Context->vcount; j++)
   {
@@ -2077,7 +2540,7 @@ int mutt_search_command(int cur, int op)
       else
       {
         mutt_message(_("Search hit bottom without finding match"));
-        return -1;
+        goto done;
       }
     }
     else if (i < 0)
@@ -2088,7 +2551,7 @@ int mutt_search_command(int cur, int op)
       else
       {
         mutt_message(_("Search hit top without finding match"));
-        return -1;
+        goto done;
       }
     }
 
@@ -2101,7 +2564,8 @@ int mutt_search_command(int cur, int op)
         mutt_clear_error();
         if (msg && *msg)
           mutt_message(msg);
-        return i;
+        rc = i;
+        goto done;
       }
     }
     else
@@ -2109,12 +2573,13 @@ int mutt_search_command(int cur, int op)
       /* remember that we've already searched this message */
       h->searched = true;
       if ((h->matched = (mutt_pattern_exec(SearchPattern, MUTT_MATCH_FULL_ADDRESS,
-                                           Context, h, NULL) > 0)))
+                                           Context, h) > 0)))
       {
         mutt_clear_error();
         if (msg && *msg)
           mutt_message(msg);
-        return i;
+        rc = i;
+        goto done;
       }
     }
 
@@ -2122,12 +2587,15 @@ int mutt_search_command(int cur, int op)
     {
       mutt_error(_("Search interrupted."));
       SigInt = 0;
-      return -1;
+      goto done;
     }
 
     i += incr;
   }
 
   mutt_error(_("Not found."));
-  return -1;
+
+done:
+  search_index_close();
+  return rc;
 }
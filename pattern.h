@@ -32,6 +32,7 @@ struct Address;
 struct Buffer;
 struct Header;
 struct Context;
+struct RangeIndex;
 
 /**
  * struct Pattern - A simple (non-regex) pattern
@@ -43,10 +44,12 @@ struct Pattern
   bool alladdr : 1;
   bool stringmatch : 1;
   bool groupmatch : 1;
-  bool ign_case : 1; /**< ignore case for local stringmatch searches */
+  bool ign_case : 1; /**< ignore case for local stringmatch searches and literals */
   bool isalias : 1;
   int min;
   int max;
+  int memo;              /**< slot for memoized results, see #MUTT_PATTERN_MEMO */
+  char *literal;         /**< plain string that every match contains */
   struct Pattern *next;
   struct Pattern *child; /**< arguments to logical op */
   union {
@@ -64,36 +67,18 @@ enum PatternExecFlag
   MUTT_MATCH_FULL_ADDRESS = 1
 };
 
-/**
- * struct PatternCache - Cache commonly-used patterns
- *
- * This is used when a message is repeatedly pattern matched against.
- * e.g. for color, scoring, hooks.  It caches a few of the potentially slow
- * operations.
- * Each entry has a value of 0 = unset, 1 = false, 2 = true
- */
-struct PatternCache
-{
-  int list_all;       /**< ^~l */
-  int list_one;       /**<  ~l */
-  int sub_all;        /**< ^~u */
-  int sub_one;        /**<  ~u */
-  int pers_recip_all; /**< ^~p */
-  int pers_recip_one; /**<  ~p */
-  int pers_from_all;  /**< ^~P */
-  int pers_from_one;  /**<  ~P */
-};
-
 static inline struct Pattern *new_pattern(void)
 {
   return safe_calloc(1, sizeof(struct Pattern));
 }
 
 int mutt_pattern_exec(struct Pattern *pat, enum PatternExecFlag flags,
-                      struct Context *ctx, struct Header *h, struct PatternCache *cache);
+                      struct Context *ctx, struct Header *h);
 struct Pattern *mutt_pattern_comp(/* const */ char *s, int flags, struct Buffer *err);
 void mutt_check_simple(char *s, size_t len, const char *simple);
 void mutt_pattern_free(struct Pattern **pat);
+void mutt_pattern_memo_invalidate(struct Header *h);
+void mutt_range_index_free(struct RangeIndex **ri);
 
 int mutt_which_case(const char *s);
 int mutt_is_list_recipient(int alladdr, struct Address *a1, struct Address *a2);
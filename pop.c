@@ -44,6 +44,7 @@
 #include "mx.h"
 #include "ncrypt/ncrypt.h"
 #include "options.h"
+#include "pattern.h"
 #include "protos.h"
 #include "url.h"
 #ifdef USE_HCACHE
@@ -665,6 +666,7 @@ static int pop_fetch_message(struct Context *ctx, struct Message *msg, int msgno
   mutt_label_hash_remove(ctx, h);
   mutt_free_envelope(&h->env);
   h->env = mutt_read_rfc822_header(msg->fp, h, 0, 0);
+  mutt_pattern_memo_invalidate(h);
   if (ctx->subj_hash && h->env->real_subj)
     hash_insert(ctx->subj_hash, h->env->real_subj, h);
   mutt_label_hash_add(ctx, h);
@@ -47,6 +47,7 @@
 #include "options.h"
 #include "parameter.h"
 #include "protos.h"
+#include "rfc822.h"
 #include "sort.h"
 #include "state.h"
 #include "thread.h"
@@ -559,7 +560,7 @@ int mutt_prepare_template(FILE *fp, struct Context *ctx, struct Header *newhdr,
   if (resend)
   {
     FREE(&newhdr->env->message_id);
-    FREE(&newhdr->env->mail_followup_to);
+    rfc822_free_address(&newhdr->env->mail_followup_to);
   }
 
   /* decrypt pgp/mime encoded messages */
@@ -142,6 +142,7 @@ const char *mutt_make_version(void);
 const char *mutt_fqdn(short may_hide_host);
 
 struct Regex *mutt_compile_regex(const char *s, int flags);
+char *mutt_regex_literal(const char *s);
 
 void mutt_account_hook(const char *url);
 void mutt_add_to_reference_headers(struct Envelope *env, struct Envelope *curenv);
@@ -73,7 +73,7 @@ static size_t convert_string(ICONV_CONST char *f, size_t flen, const char *from,
   {
     e = errno;
     FREE(&buf);
-    iconv_close(cd);
+    mutt_iconv_close(cd);
     errno = e;
     return (size_t)(-1);
   }
@@ -83,7 +83,7 @@ static size_t convert_string(ICONV_CONST char *f, size_t flen, const char *from,
 
   safe_realloc(&buf, ob - buf + 1);
   *t = buf;
-  iconv_close(cd);
+  mutt_iconv_close(cd);
 
   return n;
 }
@@ -289,11 +289,11 @@ static size_t try_block(ICONV_CONST char *d, size_t dlen, const char *fromcode,
         iconv(cd, 0, 0, &ob, &obl) == (size_t)(-1))
     {
       assert(errno == E2BIG);
-      iconv_close(cd);
+      mutt_iconv_close(cd);
       assert(ib > d);
       return (ib - d == dlen) ? dlen : ib - d + 1;
     }
-    iconv_close(cd);
+    mutt_iconv_close(cd);
   }
   else
   {
@@ -368,7 +368,7 @@ static size_t encode_block(char *s, char *d, size_t dlen, const char *fromcode,
     n1 = iconv(cd, &ib, &ibl, &ob, &obl);
     n2 = iconv(cd, 0, 0, &ob, &obl);
     assert(n1 != (size_t)(-1) && n2 != (size_t)(-1));
-    iconv_close(cd);
+    mutt_iconv_close(cd);
     return (*encoder)(s, buf1, ob - buf1, tocode);
   }
   else
@@ -646,102 +646,111 @@ void rfc2047_encode_adrlist(struct Address *addr, const char *tag)
   }
 }
 
-static int rfc2047_decode_word(char *d, const char *s, size_t len)
+/**
+ * word_charset - Get the charset of an RFC2047 encoded word
+ * @param[in]  s     Encoded word, as found by find_encoded_word()
+ * @param[out] cs    Start of the charset
+ * @param[out] cslen Length of the charset
+ */
+static void word_charset(const char *s, const char **cs, size_t *cslen)
 {
-  const char *pp = NULL, *pp1 = NULL;
-  char *pd = NULL, *d0 = NULL;
-  const char *t = NULL, *t1 = NULL;
-  int enc = 0, count = 0;
-  char *charset = NULL;
-  int rv = -1;
+  const char *t = NULL;
+  const char *end = strchr(s + 2, '?');
 
-  pd = d0 = safe_malloc(strlen(s) + 1);
+  /* ignore language specification a la RFC2231 */
+  t = memchr(s + 2, '*', end - (s + 2));
+  *cs = s + 2;
+  *cslen = (t ? t : end) - (s + 2);
+}
 
-  for (pp = s; (pp1 = strchr(pp, '?')); pp = pp1 + 1)
-  {
-    count++;
+/**
+ * decode_word - Decode the text of an RFC2047 encoded word
+ * @param buf Buffer for the result
+ * @param s   Encoded word, as found by find_encoded_word()
+ * @param x   End of the encoded word
+ *
+ * The decoded bytes, still in the word's charset, are appended to buf.  As
+ * the result is a C string, it stops at the first NUL.
+ */
+static void decode_word(struct Buffer *buf, const char *s, const char *x)
+{
+  const char *pp1 = strchr(s + 2, '?');
+  const char *end = x - 2;
+  const char *pp = NULL;
+  char *pd = NULL;
+  size_t start = buf->data ? buf->dptr - buf->data : 0;
+
+  /* make room; decoding never makes the text longer */
+  mutt_buffer_add(buf, pp1 + 3, end - (pp1 + 3));
+  pd = buf->data + start;
 
-    /* hack for non-compliant MUAs that allow unquoted question marks in encoded-text */
-    if (count == 4)
+  if (toupper((unsigned char) pp1[1]) == 'Q')
+  {
+    for (pp = pp1 + 3; pp < end; pp++)
     {
-      while (pp1 && *(pp1 + 1) != '=')
-        pp1 = strchr(pp1 + 1, '?');
-      if (!pp1)
-        goto error_out_0;
+      if (*pp == '_')
+        *pd++ = ' ';
+      else if (*pp == '=' && (!(pp[1] & ~127) && hexval(pp[1]) != -1) &&
+               (!(pp[2] & ~127) && hexval(pp[2]) != -1))
+      {
+        *pd++ = (hexval(pp[1]) << 4) | hexval(pp[2]);
+        pp += 2;
+      }
+      else
+        *pd++ = *pp;
     }
+  }
+  else
+  {
+    int c, b = 0, k = 0;
 
-    switch (count)
+    for (pp = pp1 + 3; pp < end; pp++)
     {
-      case 2:
-        /* ignore language specification a la RFC2231 */
-        t = pp1;
-        if ((t1 = memchr(pp, '*', t - pp)))
-          t = t1;
-        charset = mutt_substrdup(pp, t);
-        break;
-      case 3:
-        if (toupper((unsigned char) *pp) == 'Q')
-          enc = ENCQUOTEDPRINTABLE;
-        else if (toupper((unsigned char) *pp) == 'B')
-          enc = ENCBASE64;
-        else
-          goto error_out_0;
-        break;
-      case 4:
-        if (enc == ENCQUOTEDPRINTABLE)
-        {
-          for (; pp < pp1; pp++)
-          {
-            if (*pp == '_')
-              *pd++ = ' ';
-            else if (*pp == '=' && (!(pp[1] & ~127) && hexval(pp[1]) != -1) &&
-                     (!(pp[2] & ~127) && hexval(pp[2]) != -1))
-            {
-              *pd++ = (hexval(pp[1]) << 4) | hexval(pp[2]);
-              pp += 2;
-            }
-            else
-              *pd++ = *pp;
-          }
-          *pd = 0;
-        }
-        else if (enc == ENCBASE64)
-        {
-          int c, b = 0, k = 0;
-
-          for (; pp < pp1; pp++)
-          {
-            if (*pp == '=')
-              break;
-            if ((*pp & ~127) || (c = base64val(*pp)) == -1)
-              continue;
-            if (k + 6 >= 8)
-            {
-              k -= 2;
-              *pd++ = b | (c >> k);
-              b = c << (8 - k);
-            }
-            else
-            {
-              b |= c << (k + 2);
-              k += 6;
-            }
-          }
-          *pd = 0;
-        }
+      if (*pp == '=')
         break;
+      if ((*pp & ~127) || (c = base64val(*pp)) == -1)
+        continue;
+      if (k + 6 >= 8)
+      {
+        k -= 2;
+        *pd++ = b | (c >> k);
+        b = c << (8 - k);
+      }
+      else
+      {
+        b |= c << (k + 2);
+        k += 6;
+      }
     }
   }
 
-  if (charset)
-    mutt_convert_string(&d0, charset, Charset, MUTT_ICONV_HOOK_FROM);
-  mutt_filter_unprintable(&d0);
-  strfcpy(d, d0, len);
-  rv = 0;
-error_out_0:
-  FREE(&charset);
-  FREE(&d0);
-  return rv;
+  *pd = '\0';
+  buf->dptr = buf->data + start + strlen(buf->data + start);
+}
+
+/**
+ * convert_words - Convert decoded words to the display charset
+ * @param buf   Buffer holding the decoded text
+ * @param start Offset in buf of the words to convert
+ * @param cs    Charset of the words
+ * @param cslen Length of the charset
+ */
+static void convert_words(struct Buffer *buf, size_t start, const char *cs, size_t cslen)
+{
+  char charset[STRING];
+  char *t = NULL;
+
+  if (!cs || !buf->data || (buf->data + start == buf->dptr))
+    return;
+
+  strfcpy(charset, cs, MIN(cslen + 1, sizeof(charset)));
+  t = mutt_substrdup(buf->data + start, buf->dptr);
+  mutt_convert_string(&t, charset, Charset, MUTT_ICONV_HOOK_FROM);
+  mutt_filter_unprintable(&t);
+
+  buf->dptr = buf->data + start;
+  mutt_buffer_addstr(buf, t);
+  FREE(&t);
 }
 
 /**
@@ -784,27 +793,42 @@ static const char *find_encoded_word(const char *s, const char **x)
  *
  * try to decode anything that looks like a valid RFC2047 encoded
  * header field, ignoring RFC822 parsing rules
+ *
+ * Adjacent encoded words in the same charset are converted together, so a
+ * multibyte character may be split between them.
  */
 void rfc2047_decode(char **pd)
 {
   const char *p = NULL, *q = NULL;
   size_t m, n;
   bool found_encoded = false;
-  char *d0 = NULL, *d = NULL;
   const char *s = *pd;
-  size_t dlen;
+  struct Buffer buf;
+  const char *cs = NULL, *prev_cs = NULL;
+  size_t cslen, prev_cslen = 0;
+  size_t prev = 0; /* start of the decoded words awaiting conversion */
 
   if (!s || !*s)
     return;
 
-  dlen = 4 * strlen(s); /* should be enough */
-  d = d0 = safe_malloc(dlen + 1);
+  p = find_encoded_word(s, &q);
+  if (!p)
+  {
+    /* no encoded words */
+    if (AssumedCharset && *AssumedCharset)
+      convert_nonmime_string(pd);
+    return;
+  }
+
+  mutt_buffer_init(&buf);
 
-  while (*s && dlen > 0)
+  while (*s)
   {
-    p = find_encoded_word(s, &q);
     if (!p)
     {
+      convert_words(&buf, prev, prev_cs, prev_cslen);
+      prev_cs = NULL;
+
       /* no encoded words */
       if (option(OPT_IGNORE_LINEAR_WHITE_SPACE))
       {
@@ -812,37 +836,34 @@ void rfc2047_decode(char **pd)
         if (found_encoded && (m = lwslen(s, n)) != 0)
         {
           if (m != n)
-          {
-            *d = ' ';
-            d++;
-            dlen--;
-          }
+            mutt_buffer_addch(&buf, ' ');
           s += m;
         }
       }
       if (AssumedCharset && *AssumedCharset)
       {
-        char *t = NULL;
-        size_t tlen;
-
-        n = mutt_strlen(s);
-        t = safe_malloc(n + 1);
-        strfcpy(t, s, n + 1);
+        char *t = safe_strdup(s);
         convert_nonmime_string(&t);
-        tlen = mutt_strlen(t);
-        strncpy(d, t, tlen);
-        d += tlen;
+        mutt_buffer_addstr(&buf, t);
         FREE(&t);
         break;
       }
-      strncpy(d, s, dlen);
-      d += dlen;
+      mutt_buffer_addstr(&buf, s);
       break;
     }
 
+    n = (size_t)(p - s);
+
+    /* Blanks between encoded words are dropped, so words in the same charset
+     * can be converted together */
+    word_charset(p, &cs, &cslen);
+    bool restart = (!prev_cs || (strspn(s, " \t") != n) || (cslen != prev_cslen) ||
+                    (mutt_strncasecmp(cs, prev_cs, cslen) != 0));
+    if (restart)
+      convert_words(&buf, prev, prev_cs, prev_cslen);
+
     if (p != s)
     {
-      n = (size_t)(p - s);
       /* ignore spaces between encoded word
        * and linear-white-space between encoded word and *text */
       if (option(OPT_IGNORE_LINEAR_WHITE_SPACE))
@@ -850,11 +871,7 @@ void rfc2047_decode(char **pd)
         if (found_encoded && (m = lwslen(s, n)) != 0)
         {
           if (m != n)
-          {
-            *d = ' ';
-            d++;
-            dlen--;
-          }
+            mutt_buffer_addch(&buf, ' ');
           n -= m;
           s += m;
         }
@@ -862,44 +879,34 @@ void rfc2047_decode(char **pd)
         m = n - lwsrlen(s, n);
         if (m != 0)
         {
-          if (m > dlen)
-            m = dlen;
-          memcpy(d, s, m);
-          d += m;
-          dlen -= m;
+          mutt_buffer_add(&buf, s, m);
           if (m != n)
-          {
-            *d = ' ';
-            d++;
-            dlen--;
-          }
+            mutt_buffer_addch(&buf, ' ');
         }
       }
       else if (!found_encoded || strspn(s, " \t\r\n") != n)
       {
-        if (n > dlen)
-          n = dlen;
-        memcpy(d, s, n);
-        d += n;
-        dlen -= n;
+        mutt_buffer_add(&buf, s, n);
       }
     }
 
-    if (rfc2047_decode_word(d, p, dlen) == -1)
+    if (restart)
     {
-      /* could not decode word, fall back to displaying the raw string */
-      strfcpy(d, p, dlen);
+      prev = buf.data ? buf.dptr - buf.data : 0;
+      prev_cs = cs;
+      prev_cslen = cslen;
     }
+
+    decode_word(&buf, p, q);
     found_encoded = true;
     s = q;
-    n = mutt_strlen(d);
-    dlen -= n;
-    d += n;
+    p = find_encoded_word(s, &q);
   }
-  *d = 0;
+
+  convert_words(&buf, prev, prev_cs, prev_cslen);
 
   FREE(pd);
-  *pd = d0;
+  *pd = buf.data;
   mutt_str_adjust(pd);
 }
 
@@ -38,11 +38,18 @@ const char *const RFC822Errors[] = {
   "bad route in <>", "bad address in <>",      "bad address spec",
 };
 
+static struct Pool AddressPool = POOL_INITIALIZER(struct Address);
+
+struct Address *rfc822_new_address(void)
+{
+  return mutt_pool_alloc(&AddressPool);
+}
+
 static void free_address(struct Address *a)
 {
   FREE(&a->personal);
   FREE(&a->mailbox);
-  FREE(&a);
+  mutt_pool_free(&AddressPool, &a);
 }
 
 int rfc822_remove_from_adrlist(struct Address **a, const char *mailbox)
@@ -83,9 +90,7 @@ void rfc822_free_address(struct Address **p)
   {
     t = *p;
     *p = (*p)->next;
-    FREE(&t->personal);
-    FREE(&t->mailbox);
-    FREE(&t);
+    free_address(t);
   }
 }
 
@@ -311,6 +316,171 @@ static void add_addrspec(struct Address **top, struct Address **last, const char
   *last = cur;
 }
 
+/**
+ * is_atom_char - Can this character be part of an atom?
+ * @param c Character to test
+ * @retval true if it's neither whitespace nor a special
+ */
+static inline bool is_atom_char(char c)
+{
+  switch (c)
+  {
+    case '\0':
+    case ' ':
+    case '\t':
+    case '\r':
+    case '\n':
+    case '@':
+    case '.':
+    case ',':
+    case ':':
+    case ';':
+    case '<':
+    case '>':
+    case '[':
+    case ']':
+    case '\\':
+    case '"':
+    case '(':
+    case ')':
+      return false;
+    default:
+      return true;
+  }
+}
+
+/**
+ * simple_mailbox - Find the end of a simple "user@host" address
+ * @param s String to parse
+ * @retval ptr End of the address
+ *
+ * The address may contain atoms, dots and at most one '@'.
+ */
+static const char *simple_mailbox(const char *s)
+{
+  bool at = false;
+
+  for (;; s++)
+  {
+    if (is_atom_char(*s) || (*s == '.'))
+      continue;
+    if ((*s == '@') && !at)
+    {
+      at = true;
+      continue;
+    }
+    return s;
+  }
+}
+
+/**
+ * parse_simple_adrlist - Parse a list of simple addresses
+ * @param[in]  s   String to parse
+ * @param[out] top List of addresses
+ * @retval  0 Success
+ * @retval -1 The list needs the full parser
+ *
+ * Almost every address is either "user@host" or "Name <user@host>", with an
+ * optionally quoted name.  These are parsed straight from the string, giving
+ * the same result as the full parser.  Anything else, e.g. comments, groups,
+ * routes or escapes, makes this fail.
+ */
+static int parse_simple_adrlist(const char *s, struct Address **top)
+{
+  struct Address *last = NULL;
+  const char *p = NULL, *q = NULL;
+
+  *top = NULL;
+
+  for (s = skip_email_wsp(s); *s; s = skip_email_wsp(s))
+  {
+    char *personal = NULL;
+    const char *mbox = NULL;
+
+    if (*s == ',')
+    {
+      s++;
+      continue;
+    }
+
+    if (*s == '"')
+    {
+      /* "Name" <user@host> */
+      p = strpbrk(s + 1, "\"\\");
+      if (!p || (*p != '"') || (p - s >= LONG_STRING - 1))
+        goto fail;
+      if (p > s + 1)
+        personal = mutt_substrdup(s + 1, p);
+      s = skip_email_wsp(p + 1);
+    }
+    else if (*s != '<')
+    {
+      p = simple_mailbox(s);
+      if (p == s)
+        goto fail;
+      q = skip_email_wsp(p);
+      if ((*q == ',') || (*q == '\0'))
+      {
+        /* user@host */
+        if (p - s >= LONG_STRING - 1)
+          goto fail;
+        mbox = s;
+        s = q;
+      }
+      else
+      {
+        /* Name <user@host>: collapse the whitespace between the words */
+        for (p = s; is_atom_char(*p) || (*p == '.') || is_email_wsp(*p); p++)
+          ;
+        if ((*p != '<') || (p - s >= LONG_STRING - 1))
+          goto fail;
+
+        char *d = personal = safe_malloc(p - s + 1);
+        for (q = s; q < p; q++)
+        {
+          if (!is_email_wsp(*q))
+            *d++ = *q;
+          else if (!is_email_wsp(q[1]) && (q[1] != '<'))
+            *d++ = ' ';
+        }
+        *d = '\0';
+        s = p;
+      }
+    }
+
+    if (!mbox)
+    {
+      if (*s != '<')
+        goto fail;
+      p = simple_mailbox(s + 1);
+      if ((p == s + 1) || (*p != '>') || (p - s >= LONG_STRING - 1))
+        goto fail;
+      q = skip_email_wsp(p + 1);
+      if ((*q != ',') && (*q != '\0'))
+        goto fail;
+      mbox = s + 1;
+      s = q;
+    }
+
+    struct Address *cur = rfc822_new_address();
+    cur->personal = personal;
+    cur->mailbox = mutt_substrdup(mbox, p);
+    if (last)
+      last->next = cur;
+    else
+      *top = cur;
+    last = cur;
+    continue;
+
+  fail:
+    FREE(&personal);
+    rfc822_free_address(top);
+    return -1;
+  }
+
+  return 0;
+}
+
 struct Address *rfc822_parse_adrlist(struct Address *top, const char *s)
 {
   int ws_pending, nl;
@@ -325,6 +495,15 @@ struct Address *rfc822_parse_adrlist(struct Address *top, const char *s)
   while (last && last->next)
     last = last->next;
 
+  if (parse_simple_adrlist(s, &cur) == 0)
+  {
+    if (last)
+      last->next = cur;
+    else
+      top = cur;
+    return top;
+  }
+
   ws_pending = is_email_wsp(*s);
   if ((nl = mutt_strlen(s)))
     nl = s[nl - 1] == '\n';
@@ -44,6 +44,7 @@ enum AddressError
 
 void rfc822_dequote_comment(char *s);
 void rfc822_free_address(struct Address **p);
+struct Address *rfc822_new_address(void);
 void rfc822_qualify(struct Address *addr, const char *host);
 struct Address *rfc822_parse_adrlist(struct Address *top, const char *s);
 struct Address *rfc822_cpy_adr(struct Address *addr, int prune);
@@ -60,9 +61,4 @@ extern const char *const RFC822Errors[];
 
 #define rfc822_error(x) RFC822Errors[x]
 
-static inline struct Address *rfc822_new_address(void)
-{
-  return safe_calloc(1, sizeof(struct Address));
-}
-
 #endif /* _MUTT_RFC822_H */
@@ -103,7 +103,7 @@ int mutt_parse_score(struct Buffer *buf, struct Buffer *s, unsigned long data,
       break;
   if (!ptr)
   {
-    pat = mutt_pattern_comp(pattern, 0, err);
+    pat = mutt_pattern_comp(pattern, MUTT_PATTERN_MEMO, err);
     if (!pat)
     {
       FREE(&pattern);
@@ -142,13 +142,11 @@ int mutt_parse_score(struct Buffer *buf, struct Buffer *s, unsigned long data,
 void mutt_score_message(struct Context *ctx, struct Header *hdr, int upd_ctx)
 {
   struct Score *tmp = NULL;
-  struct PatternCache cache;
 
-  memset(&cache, 0, sizeof(cache));
   hdr->score = 0; /* in case of re-scoring */
   for (tmp = ScoreList; tmp; tmp = tmp->next)
   {
-    if (mutt_pattern_exec(tmp->pat, MUTT_MATCH_FULL_ADDRESS, NULL, hdr, &cache) > 0)
+    if (mutt_pattern_exec(tmp->pat, MUTT_MATCH_FULL_ADDRESS, NULL, hdr) > 0)
     {
       if (tmp->exact || tmp->val == 9999 || tmp->val == -9999)
       {
@@ -88,110 +88,134 @@ extern char RFC822Specials[];
 
 const char MimeSpecials[] = "@.,;:<>[]\\\"()?/= \t";
 
+/**
+ * qp_escape - Write a quoted-printable escape sequence
+ * @param dst Buffer for the escape, at least 4 bytes
+ * @param c   Character to escape
+ *
+ * The result is null-terminated, like sprintf("=%2.2X").
+ */
+static void qp_escape(char *dst, unsigned char c)
+{
+  static const char hex[] = "0123456789ABCDEF";
+
+  dst[0] = '=';
+  dst[1] = hex[c >> 4];
+  dst[2] = hex[c & 0xf];
+  dst[3] = '\0';
+}
+
 static void encode_quoted(FGETCONV *fc, FILE *fout, int istext)
 {
   int c, linelen = 0;
   char line[77], savechar;
+  char in[4096];
+  size_t n;
 
-  while ((c = fgetconv(fc)) != EOF)
+  while ((n = fgetconv_read(fc, in, sizeof(in))) > 0)
   {
-    /* Wrap the line if needed. */
-    if (linelen == 76 && ((istext && c != '\n') || !istext))
-    {
-      /* If the last character is "quoted", then be sure to move all three
-       * characters to the next line.  Otherwise, just move the last
-       * character...
-       */
-      if (line[linelen - 3] == '=')
-      {
-        line[linelen - 3] = 0;
-        fputs(line, fout);
-        fputs("=\n", fout);
-        line[linelen] = 0;
-        line[0] = '=';
-        line[1] = line[linelen - 2];
-        line[2] = line[linelen - 1];
-        linelen = 3;
-      }
-      else
-      {
-        savechar = line[linelen - 1];
-        line[linelen - 1] = '=';
-        line[linelen] = 0;
-        fputs(line, fout);
-        fputc('\n', fout);
-        line[0] = savechar;
-        linelen = 1;
-      }
-    }
-
-    /* Escape lines that begin with/only contain "the message separator". */
-    if (linelen == 4 && (mutt_strncmp("From", line, 4) == 0))
+    for (size_t i = 0; i < n; i++)
     {
-      strfcpy(line, "=46rom", sizeof(line));
-      linelen = 6;
-    }
-    else if (linelen == 4 && (mutt_strncmp("from", line, 4) == 0))
-    {
-      strfcpy(line, "=66rom", sizeof(line));
-      linelen = 6;
-    }
-    else if (linelen == 1 && line[0] == '.')
-    {
-      strfcpy(line, "=2E", sizeof(line));
-      linelen = 3;
-    }
+      c = (unsigned char) in[i];
 
-    if (c == '\n' && istext)
-    {
-      /* Check to make sure there is no trailing space on this line. */
-      if (linelen > 0 && (line[linelen - 1] == ' ' || line[linelen - 1] == '\t'))
+      /* Wrap the line if needed. */
+      if (linelen == 76 && ((istext && c != '\n') || !istext))
       {
-        if (linelen < 74)
+        /* If the last character is "quoted", then be sure to move all three
+         * characters to the next line.  Otherwise, just move the last
+         * character...
+         */
+        if (line[linelen - 3] == '=')
         {
-          sprintf(line + linelen - 1, "=%2.2X", (unsigned char) line[linelen - 1]);
+          line[linelen - 3] = 0;
           fputs(line, fout);
+          fputs("=\n", fout);
+          line[linelen] = 0;
+          line[0] = '=';
+          line[1] = line[linelen - 2];
+          line[2] = line[linelen - 1];
+          linelen = 3;
         }
         else
         {
-          int savechar2 = line[linelen - 1];
-
+          savechar = line[linelen - 1];
           line[linelen - 1] = '=';
           line[linelen] = 0;
           fputs(line, fout);
-          fprintf(fout, "\n=%2.2X", (unsigned char) savechar2);
+          fputc('\n', fout);
+          line[0] = savechar;
+          linelen = 1;
         }
       }
-      else
+
+      /* Escape lines that begin with/only contain "the message separator". */
+      if (linelen == 4 && (mutt_strncmp("From", line, 4) == 0))
       {
-        line[linelen] = 0;
-        fputs(line, fout);
+        strfcpy(line, "=46rom", sizeof(line));
+        linelen = 6;
       }
-      fputc('\n', fout);
-      linelen = 0;
-    }
-    else if (c != 9 && (c < 32 || c > 126 || c == '='))
-    {
-      /* Check to make sure there is enough room for the quoted character.
-       * If not, wrap to the next line.
-       */
-      if (linelen > 73)
+      else if (linelen == 4 && (mutt_strncmp("from", line, 4) == 0))
       {
-        line[linelen++] = '=';
-        line[linelen] = 0;
-        fputs(line, fout);
+        strfcpy(line, "=66rom", sizeof(line));
+        linelen = 6;
+      }
+      else if (linelen == 1 && line[0] == '.')
+      {
+        strfcpy(line, "=2E", sizeof(line));
+        linelen = 3;
+      }
+
+      if (c == '\n' && istext)
+      {
+        /* Check to make sure there is no trailing space on this line. */
+        if (linelen > 0 && (line[linelen - 1] == ' ' || line[linelen - 1] == '\t'))
+        {
+          if (linelen < 74)
+          {
+            qp_escape(line + linelen - 1, line[linelen - 1]);
+            fputs(line, fout);
+          }
+          else
+          {
+            int savechar2 = line[linelen - 1];
+
+            line[linelen - 1] = '=';
+            line[linelen] = 0;
+            fputs(line, fout);
+            fprintf(fout, "\n=%2.2X", (unsigned char) savechar2);
+          }
+        }
+        else
+        {
+          line[linelen] = 0;
+          fputs(line, fout);
+        }
         fputc('\n', fout);
         linelen = 0;
       }
-      sprintf(line + linelen, "=%2.2X", (unsigned char) c);
-      linelen += 3;
-    }
-    else
-    {
-      /* Don't worry about wrapping the line here.  That will happen during
-       * the next iteration when I'll also know what the next character is.
-       */
-      line[linelen++] = c;
+      else if (c != 9 && (c < 32 || c > 126 || c == '='))
+      {
+        /* Check to make sure there is enough room for the quoted character.
+         * If not, wrap to the next line.
+         */
+        if (linelen > 73)
+        {
+          line[linelen++] = '=';
+          line[linelen] = 0;
+          fputs(line, fout);
+          fputc('\n', fout);
+          linelen = 0;
+        }
+        qp_escape(line + linelen, c);
+        linelen += 3;
+      }
+      else
+      {
+        /* Don't worry about wrapping the line here.  That will happen during
+         * the next iteration when I'll also know what the next character is.
+         */
+        line[linelen++] = c;
+      }
     }
   }
 
@@ -202,7 +226,7 @@ static void encode_quoted(FGETCONV *fc, FILE *fout, int istext)
     {
       /* take care of trailing whitespace */
       if (linelen < 74)
-        sprintf(line + linelen - 1, "=%2.2X", (unsigned char) line[linelen - 1]);
+        qp_escape(line + linelen - 1, line[linelen - 1]);
       else
       {
         savechar = line[linelen - 1];
@@ -210,7 +234,7 @@ static void encode_quoted(FGETCONV *fc, FILE *fout, int istext)
         line[linelen] = 0;
         fputs(line, fout);
         fputc('\n', fout);
-        sprintf(line, "=%2.2X", (unsigned char) savechar);
+        qp_escape(line, savechar);
       }
     }
     else
@@ -220,96 +244,83 @@ static void encode_quoted(FGETCONV *fc, FILE *fout, int istext)
 }
 
 /**
- * struct B64Context - Cursor for the Base64 conversion
+ * encode_base64 - Base64-encode a file
+ * @param fc     Source of the data
+ * @param fout   File to write to
+ * @param istext If true, convert LF line endings to CRLF
+ *
+ * The data is read in blocks and encoded a whole line, 54 bytes, at a time.
+ * Every line is 72 characters long, apart from the last, and ends with a
+ * newline.
  */
-struct B64Context
-{
-  char buffer[3];
-  short size;
-  short linelen;
-};
-
-static int b64_init(struct B64Context *ctx)
-{
-  memset(ctx->buffer, '\0', sizeof(ctx->buffer));
-  ctx->size = 0;
-  ctx->linelen = 0;
-
-  return 0;
-}
-
-static void b64_flush(struct B64Context *ctx, FILE *fout)
-{
-  /* for some reasons, mutt_to_base64 expects the
-   * output buffer to be larger than 10B */
-  char encoded[11];
-  size_t ret;
-
-  if (!ctx->size)
-    return;
-
-  if (ctx->linelen >= 72)
-  {
-    fputc('\n', fout);
-    ctx->linelen = 0;
-  }
-
-  /* ret should always be equal to 4 here, because ctx->size
-   * is a value between 1 and 3 (included), but let's not hardcode it
-   * and prefer the return value of the function */
-  ret = mutt_to_base64(encoded, ctx->buffer, ctx->size, sizeof(encoded));
-  for (size_t i = 0; i < ret; i++)
-  {
-    fputc(encoded[i], fout);
-    ctx->linelen++;
-  }
-
-  ctx->size = 0;
-}
-
-static void b64_putc(struct B64Context *ctx, char c, FILE *fout)
-{
-  if (ctx->size == 3)
-    b64_flush(ctx, fout);
-
-  ctx->buffer[ctx->size++] = c;
-}
-
 static void encode_base64(FGETCONV *fc, FILE *fout, int istext)
 {
-  struct B64Context ctx;
-  int ch, ch1 = EOF;
-
-  b64_init(&ctx);
+  char in[4096];
+  char raw[2 * sizeof(in) + 54];
+  char encoded[128];
+  size_t n, rawlen = 0;
+  bool wrote = false;
+  int ch1 = EOF;
 
-  while ((ch = fgetconv(fc)) != EOF)
+  while ((n = fgetconv_read(fc, in, sizeof(in))) > 0)
   {
     if (SigInt == 1)
     {
       SigInt = 0;
       return;
     }
-    if (istext && ch == '\n' && ch1 != '\r')
-      b64_putc(&ctx, '\r', fout);
-    b64_putc(&ctx, ch, fout);
-    ch1 = ch;
+
+    if (istext)
+    {
+      for (size_t i = 0; i < n; i++)
+      {
+        if ((in[i] == '\n') && (ch1 != '\r'))
+          raw[rawlen++] = '\r';
+        raw[rawlen++] = in[i];
+        ch1 = (unsigned char) in[i];
+      }
+    }
+    else
+    {
+      memcpy(raw + rawlen, in, n);
+      rawlen += n;
+    }
+
+    size_t off = 0;
+    for (; (rawlen - off) >= 54; off += 54)
+    {
+      mutt_to_base64(encoded, raw + off, 54, sizeof(encoded));
+      fputs(encoded, fout);
+      fputc('\n', fout);
+      wrote = true;
+    }
+    memmove(raw, raw + off, rawlen - off);
+    rawlen -= off;
+  }
+
+  if (rawlen > 0)
+  {
+    mutt_to_base64(encoded, raw, rawlen, sizeof(encoded));
+    fputs(encoded, fout);
+    fputc('\n', fout);
   }
-  b64_flush(&ctx, fout);
-  fputc('\n', fout);
+  else if (!wrote)
+    fputc('\n', fout);
 }
 
 static void encode_8bit(FGETCONV *fc, FILE *fout, int istext)
 {
-  int ch;
+  char buf[4096];
+  size_t n;
 
-  while ((ch = fgetconv(fc)) != EOF)
+  while ((n = fgetconv_read(fc, buf, sizeof(buf))) > 0)
   {
     if (SigInt == 1)
     {
       SigInt = 0;
       return;
     }
-    fputc(ch, fout);
+    fwrite(buf, 1, n, fout);
   }
 }
 
@@ -547,6 +558,38 @@ static void update_content_info(struct Content *info, struct ContentState *s,
 
   for (; dlen; d++, dlen--)
   {
+    /* Once the start of a line has been checked for "From " and ".", a run of
+     * printable or 8-bit characters only changes the counters */
+    if (!was_cr && (linelen >= 4))
+    {
+      size_t n = 0, hi = 0, sp = 0;
+      for (; n < dlen; n++)
+      {
+        unsigned char c = d[n];
+        if (c & 0x80)
+          hi++;
+        else if ((c < ' ') || (c == 127))
+          break;
+
+        if (c == ' ')
+          sp++;
+        else
+          sp = 0;
+      }
+
+      if (n > 0)
+      {
+        info->hibin += hi;
+        info->ascii += n - hi;
+        linelen += n;
+        whitespace = (sp == n) ? whitespace + sp : sp;
+        d += n;
+        dlen -= n;
+        if (!dlen)
+          break;
+      }
+    }
+
     char ch = *d;
 
     if (was_cr)
@@ -653,6 +696,47 @@ static void update_content_info(struct Content *info, struct ContentState *s,
 /* Define as 1 if iconv sometimes returns -1(EILSEQ) instead of transcribing. */
 #define BUGGY_ICONV 1
 
+/**
+ * is_ascii - Is a block of text pure 7-bit ASCII?
+ * @param p Text
+ * @param n Length of text
+ * @retval true if no byte has the high bit set
+ */
+static bool is_ascii(const char *p, size_t n)
+{
+  unsigned char acc = 0;
+
+  for (size_t i = 0; i < n; i++)
+    acc |= p[i];
+
+  return !(acc & 0x80);
+}
+
+/**
+ * ascii_transparent - Does a conversion copy ASCII text unchanged?
+ * @param cd Conversion descriptor, in its initial state
+ * @retval true if every 7-bit character converts to itself
+ *
+ * This is false for encodings like UTF-16 or UTF-7 and for those that give
+ * ASCII characters, e.g. ESC, a special meaning.
+ */
+static bool ascii_transparent(iconv_t cd)
+{
+  char in[128], out[4 * sizeof(in)];
+  ICONV_CONST char *ib = in;
+  char *ob = out;
+  size_t ibl = sizeof(in), obl = sizeof(out);
+
+  for (size_t i = 0; i < sizeof(in); i++)
+    in[i] = i;
+
+  size_t n = iconv(cd, &ib, &ibl, &ob, &obl);
+  iconv(cd, 0, 0, 0, 0);
+
+  return (n == 0) && (ibl == 0) && ((size_t)(ob - out) == sizeof(in)) &&
+         (memcmp(in, out, sizeof(in)) == 0);
+}
+
 /**
  * convert_file_to - Change the encoding of a file
  * @param[in]  file       File to convert
@@ -677,37 +761,60 @@ static void update_content_info(struct Content *info, struct ContentState *s,
  * We assume that the output from iconv is never more than 4 times as
  * long as the input for any pair of charsets we might be interested
  * in.
+ *
+ * Most text is pure ASCII, which converts to itself in the usual charsets.
+ * Blocks of ASCII skip iconv for those conversions, as long as everything
+ * before them was ASCII too (a stateful encoder may need to shift back).
+ * Text that is already UTF-8 is only checked, not converted, into UTF-8.
+ * Candidates after the first UTF-8 one can never be chosen, so they aren't
+ * tried at all.
  */
 static size_t convert_file_to(FILE *file, const char *fromcode, int ncodes,
                               const char **tocodes, int *tocode, struct Content *info)
 {
   iconv_t cd1, *cd = NULL;
-  char bufi[256], bufu[512], bufo[4 * sizeof(bufi)];
+  char bufi[8192], bufu[2 * sizeof(bufi)], bufo[4 * sizeof(bufi)];
   ICONV_CONST char *ib = NULL, *ub = NULL;
   char *ob = NULL;
   size_t ibl, obl, ubl, ubl1, n, ret;
   struct Content *infos = NULL;
   struct ContentState *states = NULL;
   size_t *score = NULL;
+  bool *same = NULL;
+  bool ascii1, ascii = true;
+  bool utf8 = false, from_utf8 = mutt_is_utf8(fromcode);
 
   cd1 = mutt_iconv_open("utf-8", fromcode, 0);
   if (cd1 == (iconv_t)(-1))
     return -1;
 
+  ascii1 = ascii_transparent(cd1);
+
   cd = safe_calloc(ncodes, sizeof(iconv_t));
   score = safe_calloc(ncodes, sizeof(size_t));
   states = safe_calloc(ncodes, sizeof(struct ContentState));
   infos = safe_calloc(ncodes, sizeof(struct Content));
+  same = safe_calloc(ncodes, sizeof(bool));
 
   for (int i = 0; i < ncodes; i++)
   {
-    if (mutt_strcasecmp(tocodes[i], "utf-8") != 0)
+    if (utf8)
+    {
+      /* An earlier candidate always wins */
+      cd[i] = (iconv_t)(-1);
+    }
+    else if (mutt_strcasecmp(tocodes[i], "utf-8") != 0)
+    {
       cd[i] = mutt_iconv_open(tocodes[i], "utf-8", 0);
+      if (cd[i] != (iconv_t)(-1))
+        same[i] = ascii_transparent(cd[i]);
+    }
     else
     {
       /* Special case for conversion to UTF-8 */
       cd[i] = (iconv_t)(-1);
       score[i] = (size_t)(-1);
+      utf8 = true;
     }
   }
 
@@ -723,7 +830,26 @@ static size_t convert_file_to(FILE *file, const char *fromcode, int ncodes,
     ib = bufi;
     ob = bufu;
     obl = sizeof(bufu);
-    n = iconv(cd1, ibl ? &ib : 0, &ibl, &ob, &obl);
+    if (ascii1 && ibl && is_ascii(bufi, ibl))
+    {
+      memcpy(bufu, bufi, ibl);
+      ob += ibl;
+      ib += ibl;
+      ibl = 0;
+      n = 0;
+    }
+    else if (from_utf8 && ibl && (ubl = mutt_utf8_span(bufi, ibl)))
+    {
+      /* Keep an incomplete character for the next block.  If it's invalid,
+       * iconv will report it then. */
+      memcpy(bufu, bufi, ubl);
+      ob += ubl;
+      ib += ubl;
+      ibl -= ubl;
+      n = 0;
+    }
+    else
+      n = iconv(cd1, ibl ? &ib : 0, &ibl, &ob, &obl);
     assert(n == (size_t)(-1) || !n);
     if (n == (size_t)(-1) && ((errno != EINVAL && errno != E2BIG) || ib == bufi))
     {
@@ -733,10 +859,15 @@ static size_t convert_file_to(FILE *file, const char *fromcode, int ncodes,
     }
     ubl1 = ob - bufu;
 
+    if (ascii && !is_ascii(bufu, ubl1))
+      ascii = false;
+
     /* Convert from UTF-8 */
     for (int i = 0; i < ncodes; i++)
     {
-      if (cd[i] != (iconv_t)(-1) && score[i] != (size_t)(-1))
+      if (ascii && same[i] && score[i] != (size_t)(-1))
+        update_content_info(&infos[i], &states[i], bufu, ubl1);
+      else if (cd[i] != (iconv_t)(-1) && score[i] != (size_t)(-1))
       {
         ub = bufu;
         ubl = ubl1;
@@ -801,13 +932,14 @@ static size_t convert_file_to(FILE *file, const char *fromcode, int ncodes,
 
   for (int i = 0; i < ncodes; i++)
     if (cd[i] != (iconv_t)(-1))
-      iconv_close(cd[i]);
+      mutt_iconv_close(cd[i]);
 
-  iconv_close(cd1);
+  mutt_iconv_close(cd1);
   FREE(&cd);
   FREE(&infos);
   FREE(&score);
   FREE(&states);
+  FREE(&same);
 
   return ret;
 }
@@ -908,7 +1040,7 @@ struct Content *mutt_get_content_info(const char *fname, struct Body *b)
   FILE *fp = NULL;
   char *fromcode = NULL;
   char *tocode = NULL;
-  char buffer[100];
+  char buffer[8192];
   char chsbuf[STRING];
   size_t r;
 
@@ -48,6 +48,27 @@
 
 /* Previous values for some sidebar config */
 static short PreviousSort = SORT_ORDER; /* sidebar_sort_method */
+static char *PreviousFormat = NULL;     /* sidebar_format */
+
+/**
+ * struct SbDisplayKey - Everything a formatted sidebar entry depends on
+ *
+ * Apart from the mailbox name, which is compared separately.
+ */
+struct SbDisplayKey
+{
+  int width;
+  int sidebar_width;
+  unsigned int format_gen;
+  int msg_count;
+  int msg_unread;
+  int msg_flagged;
+  bool new;
+  bool current; /**< mailbox is the open Context */
+  int deleted;  /**< from the Context, if the mailbox is open */
+  int vcount;
+  int tagged;
+};
 
 /**
  * struct SbEntry - Info about folders in the sidebar
@@ -57,11 +78,17 @@ struct SbEntry
   char box[STRING];    /**< formatted mailbox name */
   struct Buffy *buffy; /**< Mailbox this represents */
   bool is_hidden;      /**< Don't show, e.g. $sidebar_new_mail_only */
+  int sort_key;        /**< Count the entry was sorted by, see sort_entries() */
+  bool display_valid;  /**< display holds the entry's formatted string */
+  struct SbDisplayKey display_key; /**< Inputs display was created from */
+  char display[STRING];            /**< Cached output of make_sidebar_entry() */
 };
 
 static int EntryCount = 0;
 static int EntryLen = 0;
 static struct SbEntry **Entries = NULL;
+static bool EntriesSorted = false;  /**< Entries are in $sidebar_sort_method order */
+static unsigned int FormatGen = 0; /**< Incremented when $sidebar_format changes */
 
 static int TopIndex = -1; /**< First mailbox visible in sidebar */
 static int OpnIndex = -1; /**< Current (open) mailbox */
@@ -250,6 +277,31 @@ static void make_sidebar_entry(char *buf, unsigned int buflen, int width,
   if (!buf || !box || !sbe)
     return;
 
+  /* Most redraws don't change anything that's displayed in an entry */
+  struct SbDisplayKey key;
+  memset(&key, 0, sizeof(key));
+  key.width = width;
+  key.sidebar_width = SidebarWidth;
+  key.format_gen = FormatGen;
+  key.msg_count = sbe->buffy->msg_count;
+  key.msg_unread = sbe->buffy->msg_unread;
+  key.msg_flagged = sbe->buffy->msg_flagged;
+  key.new = sbe->buffy->new;
+  if (Context && (mutt_strcmp(Context->realpath, sbe->buffy->realpath) == 0))
+  {
+    key.current = true;
+    key.deleted = Context->deleted;
+    key.vcount = Context->vcount;
+    key.tagged = Context->tagged;
+  }
+
+  if (sbe->display_valid && (memcmp(&key, &sbe->display_key, sizeof(key)) == 0) &&
+      (mutt_strcmp(box, sbe->box) == 0))
+  {
+    strfcpy(buf, sbe->display, buflen);
+    return;
+  }
+
   strfcpy(sbe->box, box, sizeof(sbe->box));
 
   mutt_expando_format(buf, buflen, 0, width, NONULL(SidebarFormat),
@@ -271,6 +323,10 @@ static void make_sidebar_entry(char *buf, unsigned int buflen, int width,
     int len = mutt_wstr_trunc(buf, buflen, width, NULL);
     buf[len] = 0;
   }
+
+  strfcpy(sbe->display, buf, sizeof(sbe->display));
+  sbe->display_key = key;
+  sbe->display_valid = true;
 }
 
 /**
@@ -406,6 +462,26 @@ static void unsort_entries(void)
   }
 }
 
+/**
+ * sbe_sort_key - Get the count that an entry is sorted by
+ * @param sbe Sidebar entry
+ * @retval num Count, or 0 if the sort method doesn't use one
+ */
+static int sbe_sort_key(const struct SbEntry *sbe)
+{
+  switch ((SidebarSortMethod & SORT_MASK))
+  {
+    case SORT_COUNT:
+      return sbe->buffy->msg_count;
+    case SORT_UNREAD:
+      return sbe->buffy->msg_unread;
+    case SORT_FLAGGED:
+      return sbe->buffy->msg_flagged;
+    default:
+      return 0;
+  }
+}
+
 /**
  * sort_entries - Sort Entries array
  *
@@ -413,7 +489,10 @@ static void unsort_entries(void)
  * option "sidebar_sort_method". This calls qsort to do the work which calls our
  * callback function "cb_qsort_sbe".
  *
- * Once sorted, the prev/next links will be reconstructed.
+ * The array is only sorted from scratch if the sort method or the set of
+ * mailboxes has changed.  Otherwise only the entries whose counts have changed
+ * since the last sort can be out of place.  An insertion sort moves them,
+ * without comparing the rest of the entries more than once.
  */
 static void sort_entries(void)
 {
@@ -421,9 +500,51 @@ static void sort_entries(void)
 
   /* These are the only sort methods we understand */
   if ((ssm == SORT_COUNT) || (ssm == SORT_UNREAD) || (ssm == SORT_FLAGGED) || (ssm == SORT_PATH))
-    qsort(Entries, EntryCount, sizeof(*Entries), cb_qsort_sbe);
-  else if ((ssm == SORT_ORDER) && (SidebarSortMethod != PreviousSort))
-    unsort_entries();
+  {
+    int changed = 0;
+
+    if (EntriesSorted && (SidebarSortMethod == PreviousSort))
+    {
+      for (int i = 0; i < EntryCount; i++)
+      {
+        int key = sbe_sort_key(Entries[i]);
+        if (key != Entries[i]->sort_key)
+        {
+          Entries[i]->sort_key = key;
+          changed++;
+        }
+      }
+      if (changed == 0)
+        return;
+    }
+
+    if (!EntriesSorted || (SidebarSortMethod != PreviousSort) || (changed > 16))
+    {
+      qsort(Entries, EntryCount, sizeof(*Entries), cb_qsort_sbe);
+      for (int i = 0; i < EntryCount; i++)
+        Entries[i]->sort_key = sbe_sort_key(Entries[i]);
+      EntriesSorted = true;
+      return;
+    }
+
+    for (int i = 1; i < EntryCount; i++)
+    {
+      struct SbEntry *sbe = Entries[i];
+      int j = i;
+      while ((j > 0) && (cb_qsort_sbe(&Entries[j - 1], &sbe) > 0))
+      {
+        Entries[j] = Entries[j - 1];
+        j--;
+      }
+      Entries[j] = sbe;
+    }
+  }
+  else
+  {
+    EntriesSorted = false;
+    if ((ssm == SORT_ORDER) && (SidebarSortMethod != PreviousSort))
+      unsort_entries();
+  }
 }
 
 /**
@@ -950,6 +1071,12 @@ void mutt_sb_draw(void)
   int num_rows = MuttSidebarWindow->rows;
   int num_cols = MuttSidebarWindow->cols;
 
+  if (mutt_strcmp(PreviousFormat, SidebarFormat) != 0)
+  {
+    mutt_str_replace(&PreviousFormat, SidebarFormat);
+    FormatGen++;
+  }
+
   int div_width = draw_divider(num_rows, num_cols);
 
   if (!Entries)
@@ -1111,7 +1238,7 @@ void mutt_sb_notify_mailbox(struct Buffy *b, int created)
   {
     if (EntryCount >= EntryLen)
     {
-      EntryLen += 10;
+      EntryLen += MAX(10, EntryLen);
       safe_realloc(&Entries, EntryLen * sizeof(struct SbEntry *));
     }
     Entries[EntryCount] = safe_calloc(1, sizeof(struct SbEntry));
@@ -1125,6 +1252,7 @@ void mutt_sb_notify_mailbox(struct Buffy *b, int created)
       OpnIndex = EntryCount;
 
     EntryCount++;
+    EntriesSorted = false;
   }
   else
   {
@@ -268,8 +268,10 @@ static int compare_label(const void *a, const void *b)
     return (SORTCODE(result));
   }
 
-  /* If both have a label, we just do a lexical compare. */
-  result = mutt_strcasecmp((*ppa)->env->x_label, (*ppb)->env->x_label);
+  /* If both have a label, we just do a lexical compare.
+   * Labels are interned, so identical labels share a pointer. */
+  if ((*ppa)->env->x_label != (*ppb)->env->x_label)
+    result = mutt_strcasecmp((*ppa)->env->x_label, (*ppb)->env->x_label);
   return (SORTCODE(result));
 }
 
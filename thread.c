@@ -141,9 +141,10 @@ static void linearize_tree(struct Context *ctx)
  * this calculates whether a node is the root of a subtree that has visible
  * nodes, whether a node itself is visible, whether, if invisible, it has
  * depth anyway, and whether any of its later siblings are roots of visible
- * subtrees.  while it's at it, it frees the old thread display, so we can
- * skip parts of the tree in mutt_draw_tree() if we've decided here that we
- * don't care about them any more.
+ * subtrees.  while it's at it, it frees the old thread display of invisible
+ * messages, so we can skip parts of the tree in mutt_draw_tree() if we've
+ * decided here that we don't care about them any more.  Visible messages
+ * keep theirs, so mutt_draw_tree() can reuse it if it hasn't changed.
  */
 static void calculate_visibility(struct Context *ctx, int *max_depth)
 {
@@ -165,7 +166,6 @@ static void calculate_visibility(struct Context *ctx, int *max_depth)
     tree->subtree_visible = 0;
     if (tree->message)
     {
-      FREE(&tree->message->tree);
       if (is_visible(tree->message, ctx))
       {
         tree->deep = true;
@@ -185,6 +185,7 @@ static void calculate_visibility(struct Context *ctx, int *max_depth)
       }
       else
       {
+        FREE(&tree->message->tree);
         tree->visible = false;
         tree->deep = !option(OPT_HIDE_LIMITED);
       }
@@ -270,6 +271,7 @@ void mutt_draw_tree(struct Context *ctx)
   calculate_visibility(ctx, &max_depth);
   pfx = safe_malloc(width * max_depth + 2);
   arrow = safe_malloc(width * max_depth + 2);
+  new_tree = safe_malloc(width * max_depth + 2);
   while (tree)
   {
     if (depth)
@@ -290,7 +292,6 @@ void mutt_draw_tree(struct Context *ctx)
       {
         myarrow[width] = MUTT_TREE_RARROW;
         myarrow[width + 1] = 0;
-        new_tree = safe_malloc((2 + depth * width));
         if (start_depth > 1)
         {
           strncpy(new_tree, pfx, (start_depth - 1) * width);
@@ -299,9 +300,13 @@ void mutt_draw_tree(struct Context *ctx)
         }
         else
           strfcpy(new_tree, arrow, 2 + depth * width);
-        tree->message->tree = new_tree;
+        /* most of the tree is unchanged after a resort or new mail */
+        if (mutt_strcmp(tree->message->tree, new_tree) != 0)
+          mutt_str_replace(&tree->message->tree, new_tree);
       }
     }
+    else if (tree->visible)
+      FREE(&tree->message->tree); /* the top of a thread has no tree */
     if (tree->child && depth)
     {
       mypfx = pfx + (depth - 1) * width;
@@ -365,6 +370,7 @@ void mutt_draw_tree(struct Context *ctx)
 
   FREE(&pfx);
   FREE(&arrow);
+  FREE(&new_tree);
 }
 
 /**
@@ -1173,7 +1179,9 @@ void mutt_set_virtual(struct Context *ctx)
       ctx->v2r[ctx->vcount] = i;
       ctx->vcount++;
       ctx->vsize += cur->content->length + cur->content->offset - cur->content->hdr_offset;
-      cur->num_hidden = mutt_get_hidden(ctx, cur);
+      /* The hidden count is only shown for collapsed threads.  Counting it
+       * for every message would walk each thread once per message in it. */
+      cur->num_hidden = cur->collapsed ? mutt_get_hidden(ctx, cur) : 0;
     }
   }
 }
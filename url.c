@@ -343,7 +343,14 @@ int url_parse_mailto(struct Envelope *e, char **body, const char *src)
   rfc2047_decode_adrlist(e->mail_followup_to);
   rfc2047_decode_adrlist(e->return_path);
   rfc2047_decode_adrlist(e->sender);
-  rfc2047_decode(&e->x_label);
+  if (e->x_label)
+  {
+    char *label = safe_strdup(e->x_label);
+    rfc2047_decode(&label);
+    mutt_str_unintern(&e->x_label);
+    e->x_label = mutt_str_intern(label);
+    FREE(&label);
+  }
   rfc2047_decode(&e->subject);
 
   rc = 0;